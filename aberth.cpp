@@ -2,9 +2,16 @@
 #include <vector>
 #include <cassert>
 #include <complex>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <cfloat>
+#include <chrono>
+#include <type_traits>
 
 // includes, project
 #include "aberth.h"
+#include "aberth_simd.h"
 
 namespace aberth
 {
@@ -13,15 +20,90 @@ namespace aberth
   //! constructor with initializer list
   //----------------------------------------------------------------------------//
   template <typename T>
-  Polynomial<T>::Polynomial(const std::vector<std::complex<T>> coeffs) :
+  Polynomial<T>::Polynomial(const std::vector<std::complex<T>> &coeffs) :
     coeffs_(coeffs),
-    deg_(coeffs.size() - 1) {}
+    deg_(coeffs.size() - 1)
+  {
+    findTerms();
+  }
 
   //----------------------------------------------------------------------------//
   //! return coeffs
   //----------------------------------------------------------------------------//
   template <typename T>
-  std::vector<std::complex<T>> Polynomial<T>::getCoeffs() const {return coeffs_;}
+  const std::vector<std::complex<T>>& Polynomial<T>::getCoeffs() const {return coeffs_;}
+
+  //----------------------------------------------------------------------------//
+  //! replace coeffs, reusing storage when the degree is unchanged
+  //! @param  coeffs    new coeffs
+  //! @param  reversed  whether or not to store them in reverse order
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void Polynomial<T>::setCoeffs(const std::vector<std::complex<T>> &coeffs,
+      const bool reversed)
+  {
+    setCoeffs(coeffs.data(), coeffs.size(), reversed);
+  }
+
+  //----------------------------------------------------------------------------//
+  //! replace coeffs, reusing storage unless the degree grows
+  //! @param  coeffs    new coeffs
+  //! @param  size      number of coeffs
+  //! @param  reversed  whether or not to store them in reverse order
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void Polynomial<T>::setCoeffs(const std::complex<T> *coeffs,
+      const unsigned int size,
+      const bool reversed)
+  {
+    if (reversed) {
+      coeffs_.assign(std::reverse_iterator<const std::complex<T> *>(coeffs + size),
+          std::reverse_iterator<const std::complex<T> *>(coeffs));
+    }
+    else coeffs_.assign(coeffs, coeffs + size);
+    deg_ = size - 1;
+    findTerms();
+  }
+
+  //----------------------------------------------------------------------------//
+  //! collect exponents of nonzero coeffs into terms_, if evaluating term by
+  //! term is cheaper than Horner's method
+  //! a gap of g between exponents takes about 2 log2(g) + 4 multiplications,
+  //! against 2 per degree for Horner's method, which also vectorizes better,
+  //! so terms are only kept if they take less than half as many
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void Polynomial<T>::findTerms()
+  {
+    // room for a term per coeff whenever coeffs_ grows, so that sparse
+    // coeffs after dense ones of the same degree don't allocate either
+    terms_.clear();
+    terms_.reserve(coeffs_.capacity());
+
+    // cost of gaps from the leading nonzero coeff down to the constant
+    unsigned long cost = 0;
+    unsigned int last = deg_ + 1;
+    for(unsigned int i = deg_ + 1; i-- > 0;) {
+      if (!i or coeffs_[i] != static_cast<std::complex<T>>(0)) {
+        if (last <= deg_) {
+          cost += 4;
+          for(unsigned int gap = last - i; gap; gap >>= 1) cost += 2;
+        }
+        if (coeffs_[i] != static_cast<std::complex<T>>(0)) last = i;
+      }
+    }
+    if (deg_ < last or deg_ <= cost) return;
+
+    for(unsigned int i = 0; i <= deg_; i++) {
+      if (coeffs_[i] != static_cast<std::complex<T>>(0)) terms_.push_back(i);
+    }
+  }
+
+  //----------------------------------------------------------------------------//
+  //! whether or not the polynomial is evaluated term by term
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  bool Polynomial<T>::isSparse() const {return !terms_.empty();}
 
   //----------------------------------------------------------------------------//
   //! use Horner's method to evaluate polynomial at x
@@ -29,6 +111,12 @@ namespace aberth
   template <typename T>
   std::complex<T> Polynomial<T>::eval(std::complex<T> x) const
   {
+    if (!terms_.empty()) {
+      std::complex<T> val,
+                      deriv;
+      const int exp = evalDerivSparse(x, val, deriv, nullptr, false);
+      return {ldexp(val.real(), exp), ldexp(val.imag(), exp)};
+    }
 
     // initialize return value as leading coeff
     std::complex<T> val = *coeffs_.crbegin();
@@ -39,6 +127,197 @@ namespace aberth
     return val;
   }
 
+  //----------------------------------------------------------------------------//
+  //! evaluate polynomial and its derivative at x in one Horner pass
+  //! @param  x      point of evaluation
+  //! @param  val    value of polynomial at x
+  //! @param  deriv  value of derivative at x
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void Polynomial<T>::evalDeriv(const std::complex<T> x,
+      std::complex<T> &val,
+      std::complex<T> &deriv) const
+  {
+    if (!terms_.empty()) {
+      const int exp = evalDerivSparse(x, val, deriv, nullptr, false);
+      val = {ldexp(val.real(), exp), ldexp(val.imag(), exp)};
+      deriv = {ldexp(deriv.real(), exp), ldexp(deriv.imag(), exp)};
+      return;
+    }
+
+    // initialize values from leading coeff
+    val = *coeffs_.crbegin();
+    deriv = 0;
+    for(auto coeffsI = ++coeffs_.crbegin(); coeffsI < coeffs_.crend(); coeffsI++) {
+      deriv = val + deriv*x;
+      val = *coeffsI + val*x;
+    }
+  }
+
+  //----------------------------------------------------------------------------//
+  //! evaluate polynomial and its derivative at x in one Horner pass, keeping
+  //! a common exponent apart from the values so that neither overflows
+  //! when both grow large, they are scaled down by a power of 2, which is
+  //! exact, and later coeffs are scaled by the accumulated exponent
+  //! the error bound is accumulated along the way as in
+  //! Higham, Accuracy and Stability of Numerical Algorithms (2002), sec. 5.1,
+  //! with an extra factor for complex multiplication
+  //! @param  x           point of evaluation
+  //! @param  val         value of polynomial at x, times 2^-exp
+  //! @param  deriv       value of derivative at x, times 2^-exp
+  //! @param  errBound    if not null, bound on rounding error of val, times 2^-exp
+  //! @param  realCoeffs  whether or not to skip imag parts of coeffs
+  //! returns exp, which is at least 0
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  int Polynomial<T>::evalDerivScaled(const std::complex<T> x,
+      std::complex<T> &val,
+      std::complex<T> &deriv,
+      T *errBound,
+      const bool realCoeffs) const
+  {
+    if (!terms_.empty()) return evalDerivSparse(x, val, deriv, errBound, realCoeffs);
+
+    // values are scaled down by 2^shift once they exceed 2^shift
+    constexpr int shift = std::numeric_limits<T>::max_exponent / 2;
+    const T big = ldexp(static_cast<T>(1), shift);
+
+    // initialize values from leading coeff
+    int exp = 0;
+    val = *coeffs_.crbegin();
+    deriv = 0;
+    T mu = errBound ? abs(val) / 2 : 0;
+    const T absX = errBound ? abs(x) : 0;
+    for(auto coeffsI = ++coeffs_.crbegin(); coeffsI < coeffs_.crend(); coeffsI++) {
+      deriv = val + deriv*x;
+      if (realCoeffs) {
+        val *= x;
+        val.real(val.real() + (exp ? ldexp(coeffsI->real(), -exp) : coeffsI->real()));
+      }
+      else {
+        val = val*x + (exp ? std::complex<T>(ldexp(coeffsI->real(), -exp),
+              ldexp(coeffsI->imag(), -exp)) : *coeffsI);
+      }
+      if (errBound) mu = absX*mu + abs(val);
+
+      // rescale
+      if (big < std::max(std::max(abs(val.real()), abs(val.imag())),
+            std::max(abs(deriv.real()), abs(deriv.imag())))) {
+        val = {ldexp(val.real(), -shift), ldexp(val.imag(), -shift)};
+        deriv = {ldexp(deriv.real(), -shift), ldexp(deriv.imag(), -shift)};
+        mu = ldexp(mu, -shift);
+        exp += shift;
+      }
+    }
+
+    if (errBound) {
+      *errBound = 2 * sqrt(static_cast<T>(2)) *
+        std::numeric_limits<T>::epsilon() * (2*mu - abs(val));
+    }
+
+    return exp;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! evaluate polynomial and its derivative at x term by term, skipping the
+  //! zero coeffs that Horner's method would step through
+  //! between exponents e > f, the values are multiplied by x^g, g = e - f,
+  //! using x^(g - 1) found by repeated squaring:
+  //! p <- p x^g + a_f  and  p' <- p' x^g + g p x^(g - 1)
+  //! for g = 1, this is the step of evalDerivScaled, and the error bound
+  //! grows as it would over g steps with zero coeffs
+  //! values are scaled as in evalDerivScaled, and so are powers, which
+  //! keeps every product finite for |x| < 2^(max_exponent / 4)
+  //! returns exp, which is at least 0
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  int Polynomial<T>::evalDerivSparse(const std::complex<T> x,
+      std::complex<T> &val,
+      std::complex<T> &deriv,
+      T *errBound,
+      const bool realCoeffs) const
+  {
+
+    // values are scaled down by 2^shift once they exceed 2^shift, and
+    // powers once they exceed 2^(shift / 2)
+    constexpr int shift = std::numeric_limits<T>::max_exponent / 2;
+    const T big = ldexp(static_cast<T>(1), shift),
+            mid = ldexp(static_cast<T>(1), shift / 2);
+    auto largest = [](const std::complex<T> v) {
+      return std::max(abs(v.real()), abs(v.imag()));
+    };
+    auto scale = [](std::complex<T> &v) {
+      v = {ldexp(v.real(), -shift), ldexp(v.imag(), -shift)};
+    };
+
+    // x^m, times 2^-exp, by repeated squaring
+    auto power = [&](unsigned int m, std::complex<T> &pow) {
+      std::complex<T> square = x;
+      int exp = 0,
+          squareExp = 0;
+      pow = 1;
+      for(; m; m >>= 1) {
+        if (m & 1) {
+          pow *= square;
+          exp += squareExp;
+          if (mid < largest(pow)) {scale(pow); exp += shift;}
+        }
+        if (1 < m) {
+          square *= square;
+          squareExp *= 2;
+          if (mid < largest(square)) {scale(square); squareExp += shift;}
+        }
+      }
+      return exp;
+    };
+
+    // initialize values from leading coeff
+    int exp = 0;
+    unsigned int k = terms_.size() - 1;
+    val = coeffs_[terms_[k]];
+    deriv = 0;
+    T mu = errBound ? abs(val) / 2 : 0;
+    for(unsigned int e = terms_[k]; 0 < e;) {
+      const unsigned int f = k ? terms_[--k] : 0,
+                         gap = e - f;
+
+      // x^(gap - 1) and x^gap, times 2^-powExp
+      std::complex<T> pow;
+      const int powExp = power(gap - 1, pow);
+      const std::complex<T> powX = pow * x;
+      exp += powExp;
+
+      deriv = deriv*powX + val*(static_cast<T>(gap) * pow);
+      if (errBound) mu = abs(powX)*(mu + (gap - 1)*abs(val));
+      const std::complex<T> coeff = coeffs_[f];
+      if (realCoeffs) {
+        val *= powX;
+        val.real(val.real() + (exp ? ldexp(coeff.real(), -exp) : coeff.real()));
+      }
+      else {
+        val = val*powX + (exp ? std::complex<T>(ldexp(coeff.real(), -exp),
+              ldexp(coeff.imag(), -exp)) : coeff);
+      }
+      if (errBound) mu += abs(val);
+
+      // rescale
+      if (big < std::max(largest(val), largest(deriv))) {
+        scale(val);
+        scale(deriv);
+        mu = ldexp(mu, -shift);
+        exp += shift;
+      }
+      e = f;
+    }
+
+    if (errBound) {
+      *errBound = 2 * sqrt(static_cast<T>(2)) *
+        std::numeric_limits<T>::epsilon() * (2*mu - abs(val));
+    }
+
+    return exp;
+  }
+
   //----------------------------------------------------------------------------//
   //! compute coeffs of this polynomial's derivative
   //----------------------------------------------------------------------------//
@@ -77,9 +356,40 @@ namespace aberth
     allConv_(other.allConv_),
     conv_(other.conv_),
     invDiffSum_(other.invDiffSum_),
-    deriv_(std::make_unique<Polynomial<T>>(other.deriv_->getCoeffs())),
+    zerosRe_(other.zerosRe_),
+    zerosIm_(other.zerosIm_),
+    isa_(other.isa_),
+    pool_(other.pool_),
+    convCounts_(other.convCounts_),
+    sumMode_(other.sumMode_),
+    fmm_(other.fmm_ ? std::make_unique<CauchyFmm>(other.fmm_->getTol()) : nullptr),
+    activeSet_(other.activeSet_),
+    active_(other.active_),
+    updateMode_(other.updateMode_),
+    logDeriv_(other.logDeriv_),
+    resid_(other.resid_),
     rev_(std::make_unique<Polynomial<T>>(other.rev_->getCoeffs())),
-    revDeriv_(std::make_unique<Polynomial<T>>(other.revDeriv_->getCoeffs()))
+    precisionMode_(other.precisionMode_),
+    stallTol_(other.stallTol_),
+    stopCriterion_(other.stopCriterion_),
+    bound_(other.bound_),
+    origin_(other.origin_),
+    stats_(other.stats_),
+    collectStats_(other.collectStats_),
+    iterCallback_(other.iterCallback_),
+    realCoeffs_(other.realCoeffs_),
+    mirror_(other.mirror_),
+    splitWidth_(other.splitWidth_),
+    clusterDetection_(other.clusterDetection_),
+    cluster_(other.cluster_),
+    mult_(other.mult_),
+    centers_(other.centers_),
+    clusterAge_(other.clusterAge_),
+    clusterWait_(other.clusterWait_),
+    rng_(other.rng_),
+    deadline_(other.deadline_),
+    cancelToken_(other.cancelToken_),
+    stalled_(other.stalled_.size())
   {}
 
   //----------------------------------------------------------------------------//
@@ -96,9 +406,40 @@ namespace aberth
     allConv_(std::move(other.allConv_)),
     conv_(std::move(other.conv_)),
     invDiffSum_(std::move(other.invDiffSum_)),
-    deriv_(std::move(other.deriv_)),
+    zerosRe_(std::move(other.zerosRe_)),
+    zerosIm_(std::move(other.zerosIm_)),
+    isa_(std::move(other.isa_)),
+    pool_(std::move(other.pool_)),
+    convCounts_(std::move(other.convCounts_)),
+    sumMode_(std::move(other.sumMode_)),
+    fmm_(std::move(other.fmm_)),
+    activeSet_(std::move(other.activeSet_)),
+    active_(std::move(other.active_)),
+    updateMode_(std::move(other.updateMode_)),
+    logDeriv_(std::move(other.logDeriv_)),
+    resid_(std::move(other.resid_)),
     rev_(std::move(other.rev_)),
-    revDeriv_(std::move(other.revDeriv_))
+    precisionMode_(std::move(other.precisionMode_)),
+    stallTol_(std::move(other.stallTol_)),
+    stopCriterion_(std::move(other.stopCriterion_)),
+    bound_(std::move(other.bound_)),
+    origin_(std::move(other.origin_)),
+    stats_(std::move(other.stats_)),
+    collectStats_(std::move(other.collectStats_)),
+    iterCallback_(std::move(other.iterCallback_)),
+    realCoeffs_(std::move(other.realCoeffs_)),
+    mirror_(std::move(other.mirror_)),
+    splitWidth_(std::move(other.splitWidth_)),
+    clusterDetection_(std::move(other.clusterDetection_)),
+    cluster_(std::move(other.cluster_)),
+    mult_(std::move(other.mult_)),
+    centers_(std::move(other.centers_)),
+    clusterAge_(std::move(other.clusterAge_)),
+    clusterWait_(std::move(other.clusterWait_)),
+    rng_(std::move(other.rng_)),
+    deadline_(std::move(other.deadline_)),
+    cancelToken_(std::move(other.cancelToken_)),
+    stalled_(std::move(other.stalled_))
   {}
 
   //----------------------------------------------------------------------------//
@@ -117,9 +458,40 @@ namespace aberth
     std::swap(first.allConv_, second.allConv_);
     std::swap(first.conv_, second.conv_);
     std::swap(first.invDiffSum_, second.invDiffSum_);
-    std::swap(first.deriv_, second.deriv_);
+    std::swap(first.zerosRe_, second.zerosRe_);
+    std::swap(first.zerosIm_, second.zerosIm_);
+    std::swap(first.isa_, second.isa_);
+    std::swap(first.pool_, second.pool_);
+    std::swap(first.convCounts_, second.convCounts_);
+    std::swap(first.sumMode_, second.sumMode_);
+    std::swap(first.fmm_, second.fmm_);
+    std::swap(first.activeSet_, second.activeSet_);
+    std::swap(first.active_, second.active_);
+    std::swap(first.updateMode_, second.updateMode_);
+    std::swap(first.logDeriv_, second.logDeriv_);
+    std::swap(first.resid_, second.resid_);
     std::swap(first.rev_, second.rev_);
-    std::swap(first.revDeriv_, second.revDeriv_);
+    std::swap(first.precisionMode_, second.precisionMode_);
+    std::swap(first.stallTol_, second.stallTol_);
+    std::swap(first.stopCriterion_, second.stopCriterion_);
+    std::swap(first.bound_, second.bound_);
+    std::swap(first.origin_, second.origin_);
+    std::swap(first.stats_, second.stats_);
+    std::swap(first.collectStats_, second.collectStats_);
+    std::swap(first.iterCallback_, second.iterCallback_);
+    std::swap(first.realCoeffs_, second.realCoeffs_);
+    std::swap(first.mirror_, second.mirror_);
+    std::swap(first.splitWidth_, second.splitWidth_);
+    std::swap(first.clusterDetection_, second.clusterDetection_);
+    std::swap(first.cluster_, second.cluster_);
+    std::swap(first.mult_, second.mult_);
+    std::swap(first.centers_, second.centers_);
+    std::swap(first.clusterAge_, second.clusterAge_);
+    std::swap(first.clusterWait_, second.clusterWait_);
+    std::swap(first.rng_, second.rng_);
+    std::swap(first.deadline_, second.deadline_);
+    std::swap(first.cancelToken_, second.cancelToken_);
+    std::swap(first.stalled_, second.stalled_);
   }
 
   //----------------------------------------------------------------------------//
@@ -136,13 +508,19 @@ namespace aberth
   //----------------------------------------------------------------------------//
   // compute initial guesses for zeros
   // also initialize other values
+  // a finder whose zeros are then set by another skips the guesses and
+  // their evaluations, which are left to the other
   //----------------------------------------------------------------------------//
   template <typename T>
-  void ZeroFinder<T>::initData()
+  void ZeroFinder<T>::initData(const bool guess)
   {
 
     // compute initial guesses for zeros
-    initZeros();
+    if (guess) initZeros();
+    else {
+      zeros_.resize(this->deg_);
+      mirror_.resize(this->deg_);
+    }
 
     // resize and fill vector members
     conv_.resize(this->deg_);
@@ -151,6 +529,31 @@ namespace aberth
     invDiffSum_.resize(this->deg_);
     std::fill(invDiffSum_.begin(), invDiffSum_.end(), 0);
 
+    zerosRe_.resize(this->deg_);
+    zerosIm_.resize(this->deg_);
+
+    splitWidth_.resize(this->deg_);
+    std::fill(splitWidth_.begin(), splitWidth_.end(), 0);
+
+    // no clusters yet
+    cluster_.assign(this->deg_, this->deg_);
+    mult_.assign(this->deg_, 1);
+    centers_.resize(this->deg_);
+    clusterAge_.assign(this->deg_, 0);
+    clusterWait_.assign(this->deg_, 0);
+
+    // so that adaptive solves mark stalled zeros without allocation
+    stalled_.resize(this->deg_);
+
+    // evaluate at initial guesses
+    logDeriv_.resize(this->deg_);
+    resid_.resize(this->deg_);
+    bound_.resize(stopCriterion_ == "bound" or precisionMode_ == "adaptive" ?
+        this->deg_ : 0);
+    if (guess) {
+      for(unsigned int i = 0; i < this->deg_; i++) compLogDeriv(i);
+    }
+
     // other data
     iters_ = 0;
     allConv_ = false;
@@ -163,25 +566,35 @@ namespace aberth
   void ZeroFinder<T>::initZeros()
   {
 
-    // real and imag component of guesses and upper bound on all zeros' magnitude
-    T a,
-      b,
-      rMax = ZeroFinder<T>::compBound();
+    // each zero is its own conjugate until paired
+    zeros_.resize(this->deg_);
+    mirror_.resize(this->deg_);
+    for(unsigned int i = 0; i < this->deg_; i++) mirror_[i] = i;
+
+    // guesses on circles from the newton polygon
+    if (initMode_ == "newton") {newtonPolygonZeros(); return;}
+
+    // upper bound on all zeros' magnitude
+    const T rMax = ZeroFinder<T>::compBound();
+
+    // two uniform draws for the real and imag component of each random
+    // guess, drawn at once from this finder's own stream
+    const unsigned int nGuesses = initMode_ == "symm" ? 1 : this->deg_;
+    draws_.resize(2 * nGuesses);
+    rng_.fill(draws_.data(), 2 * nGuesses);
+    auto guess = [&](const unsigned int k) {
+      const T a = rMax * draws_[2 * k];
+      return std::complex<T>(a, sqrt(rMax*rMax - a*a) * draws_[2 * k + 1]);
+    };
 
     // initial zero for symm
     std::complex<T> z;
 
     // compute a guess for each root
-    zeros_.resize(this->deg_);
     for(unsigned int i = 0; i < this->deg_; i++) {
 
       // generate components of guess
-      if (initMode_ == "rand" or (initMode_ == "symm" and !i)) {
-        a = rMax * (static_cast<T>(std::rand()) / static_cast<T>(RAND_MAX));
-        b = sqrt(rMax*rMax - a*a) * (static_cast<T>(std::rand()) /
-            static_cast<T>(RAND_MAX));
-        z = {a, b};
-      }
+      if (initMode_ == "rand" or (initMode_ == "symm" and !i)) z = guess(i);
 
       //**************************************//
       // symmetrically distribute initial guesses
@@ -220,61 +633,1003 @@ namespace aberth
   }
 
   //----------------------------------------------------------------------------//
-  //! compute invDiffSum elts
+  //! place initial guesses on circles whose radii come from the upper convex
+  //! hull of (i, log|a_i|), as in
+  //! Bini, Numerical Algorithms 13 (1996) 179-200
+  //! an edge from i to j of the hull gets j - i guesses on the circle of radius
+  //! (|a_i| / |a_j|)^(1 / (j - i))
   //----------------------------------------------------------------------------//
   template <typename T>
-  void ZeroFinder<T>::compInvDiffSum()
+  void ZeroFinder<T>::newtonPolygonZeros()
   {
+    const T twoPi = static_cast<T>(2 * M_PI),
+            sigma = static_cast<T>(0.7);
 
-    // compute for each zero
+    // upper convex hull of points with nonzero coeffs
+    std::vector<unsigned int> &hull = hull_;
+    std::vector<T> &logs = logs_;
+    hull.clear();
+    logs.resize(this->deg_ + 1);
+    for(unsigned int i = 0; i <= this->deg_; i++) {
+      if (this->coeffs_[i] == static_cast<std::complex<T>>(0)) continue;
+      logs[i] = log(abs(this->coeffs_[i]));
+      while (2 <= hull.size()) {
+        const unsigned int j = hull[hull.size() - 1],
+                           k = hull[hull.size() - 2];
+
+        // drop j if it lies on or below the segment from k to i
+        if ((logs[j] - logs[k]) * (i - k) <= (logs[i] - logs[k]) * (j - k)) hull.pop_back();
+        else break;
+      }
+      hull.push_back(i);
+    }
+
+    // smallest radius of the hull
+    T rMin = 1;
+    for(unsigned int e = 0; e + 1 < hull.size(); e++) {
+      const T r = exp((logs[hull[e]] - logs[hull[e + 1]]) / (hull[e + 1] - hull[e]));
+      if (!e or r < rMin) rMin = r;
+    }
+
+    // zeros at the origin start where |p| is already below tol
+    if (hull[0]) {
+      const T r = std::min(rMin, pow(tol_ / abs(this->coeffs_[hull[0]]),
+            static_cast<T>(1) / hull[0])) / 2;
+      circleZeros(0, hull[0], r, sigma);
+    }
+
+    // guesses on the circle of each edge
+    for(unsigned int e = 0; e + 1 < hull.size(); e++) {
+      const unsigned int m = hull[e + 1] - hull[e];
+      const T r = exp((logs[hull[e]] - logs[hull[e + 1]]) / m);
+      circleZeros(hull[e], m, r, twoPi * hull[e] / this->deg_ + sigma);
+    }
+  }
+
+  //----------------------------------------------------------------------------//
+  //! place m guesses evenly on the circle of radius r, from the ith zero on
+  //! @param  i      index of first guess
+  //! @param  m      number of guesses
+  //! @param  r      radius
+  //! @param  angle  angle of the first guess
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::circleZeros(const unsigned int i,
+      const unsigned int m,
+      const T r,
+      const T angle)
+  {
+    const T twoPi = static_cast<T>(2 * M_PI);
+    for(unsigned int j = 0; j < m; j++) zeros_[i + j] = std::polar(r, twoPi * j / m + angle);
+  }
+
+  //----------------------------------------------------------------------------//
+  //! collect the zeros iterated in each sweep into active_
+  //! with real coeffs, only one zero of each conjugate pair is iterated,
+  //! with activeSet_, only those not converged, and zeros of clusters are
+  //! iterated by updateClusters instead
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::buildRows()
+  {
+    active_.clear();
     for(unsigned int i = 0; i < this->deg_; i++) {
-      invDiffSum_[i] = {0, 0};
-      for(unsigned int j = 0; j < this->deg_; j++) {
-        if (i != j) invDiffSum_[i] += static_cast<std::complex<T>>(1) /
-                                    (zeros_[i] - zeros_[j]);
+      if ((activeSet_ or realCoeffs_ or clusterDetection_) and i <= mirror_[i] and
+          !(activeSet_ and conv_[i]) and cluster_[i] == this->deg_) active_.push_back(i);
+    }
+  }
+
+  //----------------------------------------------------------------------------//
+  //! number of zeros iterated in each sweep
+  //! all of them, or only those collected by buildRows
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  unsigned int ZeroFinder<T>::numRows() const
+  {
+    return activeSet_ or realCoeffs_ or clusterDetection_ ? active_.size() : this->deg_;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! index of the kth zero iterated in each sweep
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  unsigned int ZeroFinder<T>::row(const unsigned int k) const
+  {
+    return activeSet_ or realCoeffs_ or clusterDetection_ ? active_[k] : k;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! copy rows [begin, end) of zeros, and their conjugates, to real and
+  //! imag arrays for the vectorized kernel in compInvDiffSum
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::splitZeros(const unsigned int begin, const unsigned int end)
+  {
+    for(unsigned int k = begin; k < end; k++) {
+      const unsigned int i = row(k),
+                         j = mirror_[i];
+      zerosRe_[i] = zeros_[i].real();
+      zerosIm_[i] = zeros_[i].imag();
+      if (j != i) {zerosRe_[j] = zerosRe_[i]; zerosIm_[j] = -zerosIm_[i];}
+    }
+  }
+
+  //----------------------------------------------------------------------------//
+  //! compute invDiffSum elts for rows [begin, end)
+  //! all zeros must have been split by splitZeros
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::compInvDiffSum(const unsigned int begin,
+      const unsigned int end)
+  {
+
+    // compute for each zero
+    T sRe, sIm;
+    for(unsigned int k = begin; k < end; k++) {
+      const unsigned int i = row(k);
+      simd::invDiffSumRow(zerosRe_.data(), zerosIm_.data(), this->deg_, i,
+          sRe, sIm, isa_);
+      invDiffSum_[i] = {sRe, sIm};
+    }
+  }
+
+  //----------------------------------------------------------------------------//
+  //! a / b, like built-in complex division even for class types T, whose
+  //! generic division squares |b| unscaled and gives nan for b = 0: b is
+  //! scaled to about 1 first, a / 0 is huge and a / inf is 0
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  static std::complex<T> divide(const std::complex<T> &a, const std::complex<T> &b)
+  {
+    if constexpr (!std::is_floating_point<T>::value) {
+      const double m = std::max(std::abs(static_cast<double>(b.real())),
+                                std::abs(static_cast<double>(b.imag())));
+      if (m == 0) return std::numeric_limits<T>::max();
+      if (std::isinf(m)) return static_cast<T>(0);
+      if (!std::isnan(m)) {
+        const int e = std::ilogb(m);
+        const T re = ldexp(b.real(), -e),
+                im = ldexp(b.imag(), -e),
+                inv = 1 / (re * re + im * im);
+        return {ldexp((a.real() * re + a.imag() * im) * inv, -e),
+                ldexp((a.imag() * re - a.real() * im) * inv, -e)};
       }
     }
+    return a / b;
   }
 
   //----------------------------------------------------------------------------//
-  //! update zeros
-  //! use of reverse polynomial comes from
-  //! Bini, Numerical Algorithms 13 (1996) 179-200
-  //! https://link.springer.com/article/10.1007/BF02207694
+  //! update rows [begin, end) of zeros
+  //! returns the number of converged zeros in rows [begin, end)
   //----------------------------------------------------------------------------//
   template <typename T>
-  void ZeroFinder<T>::newtonStep()
+  unsigned int ZeroFinder<T>::newtonStep(const unsigned int begin,
+      const unsigned int end)
   {
 
-    // ratio of polynomial evaluated at z to its derivative evaluated at z
     // correction to be applied
-    std::complex<T> ratio,
-                    corr;
+    std::complex<T> corr;
+
+    // number of converged zeros
+    unsigned int nConv = 0;
 
     // consider each zero
-    for(unsigned int i = 0; i < this->deg_; i++) {
+    for(unsigned int k = begin; k < end; k++) {
+      const unsigned int i = row(k);
 
-      // if magnitude of zero is less than 1, then will likely avoid overflow
-      if (abs(zeros_[i]) < 1) ratio = this->eval(zeros_[i]) / deriv_->eval(zeros_[i]);
+      // compute and apply new correction from p' / p evaluated last step
+      // p / p' may not be representable, but the correction tends to
+      // -1 / invDiffSum_ as p' / p vanishes, and to 0 as it blows up
+      corr = divide(static_cast<std::complex<T>>(1), logDeriv_[i] - invDiffSum_[i]);
 
-      // otherwise, we have to use reverse polynomial
-      else {
-        std::complex<T> gamma = static_cast<std::complex<T>>(1) / zeros_[i];
-        ratio = static_cast<std::complex<T>>(1) /
-               (static_cast<std::complex<T>>(this->deg_) * gamma - 
-               (gamma * gamma * revDeriv_->eval(gamma) / rev_->eval(gamma)));
+      // the zeros of a pair repel each other across the real axis, so a pair
+      // near two real zeros only heads for them once their repulsion is left
+      // out, and updatePairs may then split it by the length of that step
+      // only a pair within a few steps of the real axis can be near them,
+      // and a zero on its own keeps the length of its step for pairZeros
+      const unsigned int j = mirror_[i];
+      if (j != i and abs(zeros_[i].imag()) <= PAIR_SEPARATION * abs(corr)) {
+        const std::complex<T> free = divide(static_cast<std::complex<T>>(1), logDeriv_[i] -
+            invDiffSum_[i] + static_cast<std::complex<T>>(1) / (zeros_[i] - zeros_[j]));
+        splitWidth_[i] = !conv_[i] and (zeros_[i] - free).imag() <= zeros_[i].imag() / 4 ?
+          abs(free) : 0;
       }
+      else splitWidth_[i] = j != i ? 0 : abs(corr);
 
-      // compute and apply new correction
-      corr = ratio / (static_cast<std::complex<T>>(1) -
-            (ratio * invDiffSum_[i]));
+      // unpaired zeros of real coeffs stay real, up to rounding, unless
+      // releasePairs moved them off the real axis
+      const bool real = realCoeffs_ and j == i and !zeros_[i].imag();
       zeros_[i] -= corr;
+      if (real) zeros_[i].imag(0);
 
-      // determine if ith zero has converged after applying correction
+      // a single evaluation gives the residual for the convergence test
+      // and p' / p for the next step
+      compLogDeriv(i);
+
+      // determine if ith zero has converged after applying correction,
+      // |p| is down to the rounding error of its evaluation,
+      // or it stopped moving at the working precision
       if (!conv_[i]) {
-        if (static_cast<T>(abs(this->eval(zeros_[i]))) < tol_) conv_[i] = true;
+        if (resid_[i] < tol_ or (!bound_.empty() and 1 <= bound_[i]) or
+            (stallTol_ and abs(corr) <= stallTol_ * abs(zeros_[i]))) conv_[i] = true;
+      }
+      if (conv_[i]) nConv++;
+
+      // the conjugate of a pair follows without being evaluated
+      if (j != i) {
+        zeros_[j] = std::conj(zeros_[i]);
+        logDeriv_[j] = std::conj(logDeriv_[i]);
+        resid_[j] = resid_[i];
+        if (!bound_.empty()) bound_[j] = bound_[i];
+        conv_[j] = conv_[i];
       }
     }
+
+    return nConv;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! evaluate logarithmic derivative p' / p and residual |p| at the ith zero
+  //! use of reverse polynomial comes from
+  //! Bini, Numerical Algorithms 13 (1996) 179-200
+  //! https://link.springer.com/article/10.1007/BF02207694
+  //! evaluation is scaled, and the residual is formed from logs, since |p|
+  //! may be far outside the range of T when the degree is large
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::compLogDeriv(const unsigned int i)
+  {
+    evalLogDeriv(zeros_[i], logDeriv_[i], resid_[i], bound_.empty() ? nullptr : &bound_[i]);
+  }
+
+  //----------------------------------------------------------------------------//
+  //! evaluate logarithmic derivative p' / p and residual |p| at z, along
+  //! with the bound on the rounding error of p relative to |p| if bound is set
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::evalLogDeriv(const std::complex<T> z,
+      std::complex<T> &logDeriv,
+      T &resid,
+      T *bound) const
+  {
+
+    // values of polynomial (or its reverse) and derivative, times 2^-exp
+    std::complex<T> val,
+                    deriv;
+
+    // bound on rounding error, if set, is divided by |p| before either is
+    // unscaled so that overflow of both can't pass the test
+
+    // if magnitude of zero is less than 1, then will likely avoid overflow
+    const T mag = abs(z);
+    if (mag < 1) {
+      const int exp = this->evalDerivScaled(z, val, deriv, bound, realCoeffs_);
+      logDeriv = divide(deriv, val);
+      resid = ldexp(abs(val), exp);
+      if (bound) *bound /= abs(val);
+    }
+
+    // otherwise, we have to use reverse polynomial, p(z) = z^n rev(1 / z)
+    // so |p(z)| = 2^(log2|rev(1 / z)| + n log2|z|)
+    else {
+      std::complex<T> gamma = static_cast<std::complex<T>>(1) / z;
+      const int exp = rev_->evalDerivScaled(gamma, val, deriv, bound, realCoeffs_);
+      logDeriv = static_cast<std::complex<T>>(this->deg_) * gamma -
+             divide(gamma * gamma * deriv, val);
+      resid = exp2(log2(abs(val)) + exp +
+          this->deg_ * log2(mag));
+      if (bound) *bound /= abs(val);
+    }
+  }
+
+  //----------------------------------------------------------------------------//
+  //! whether p is negative at a real point, for real coeffs
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  bool ZeroFinder<T>::negativeAt(const T x)
+  {
+    std::complex<T> val,
+                    deriv;
+    countEval(x);
+    if (abs(x) < 1) {
+      this->evalDerivScaled(x, val, deriv, nullptr, true);
+      return val.real() < 0;
+    }
+
+    // p(x) = x^n rev(1 / x)
+    rev_->evalDerivScaled(1 / x, val, deriv, nullptr, true);
+    return (val.real() < 0) != (x < 0 and this->deg_ % 2);
+  }
+
+  //----------------------------------------------------------------------------//
+  //! pair up the zeros of real coeffs once they have sorted themselves out
+  //! the zeros of a pair repel each other across the real axis, so pairs
+  //! close in on real zeros slowly, and zeros are iterated on their own at
+  //! first: after each sweep, each zero not yet paired is matched with the
+  //! zero closest to its conjugate, which is itself for a zero near the
+  //! real axis, and each match that is mutual and PAIR_SEPARATION times
+  //! closer than any other zero is paired right away, the second zero
+  //! following the first as its conjugate, while zeros matched with
+  //! themselves or ambiguously stay on their own, as do zeros whose last
+  //! step could still take them PAIR_SEPARATION times to the real axis
+  //! returns whether or not every zero off the real axis that hasn't
+  //! converged is paired
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  bool ZeroFinder<T>::pairZeros()
+  {
+    const unsigned int n = this->deg_;
+
+    // zeros not yet paired, by real part
+    std::vector<unsigned int> &single = invPerm_;
+    single.clear();
+    for(unsigned int i = 0; i < n; i++) {
+      if (mirror_[i] == i) single.push_back(i);
+    }
+    std::sort(single.begin(), single.end(), [this](const unsigned int v, const unsigned int w)
+        {return zeros_[v].real() < zeros_[w].real();});
+
+    // closest and second closest zero to the conjugate of each, which has
+    // the same real part, looking outwards while the real parts are closer
+    // than the second closest so far
+    std::vector<unsigned int> &match = hull_;
+    match.resize(n);
+    for(unsigned int k = 0; k < single.size(); k++) {
+      const std::complex<T> conj = std::conj(zeros_[single[k]]);
+      T first = std::numeric_limits<T>::max(),
+        second = first;
+      auto consider = [&](const unsigned int l) {
+        const T dist = abs(zeros_[single[l]] - conj);
+        if (dist < first) {
+          second = first;
+          first = dist;
+          match[single[k]] = single[l];
+        }
+        else if (dist < second) second = dist;
+      };
+      for(unsigned int l = k; l < single.size() and
+          zeros_[single[l]].real() - conj.real() < second; l++) consider(l);
+      for(unsigned int l = k; l-- > 0 and conj.real() - zeros_[single[l]].real() < second;) {
+        consider(l);
+      }
+      const T step = splitWidth_[single[k]];
+      if (!(PAIR_SEPARATION * first < second and
+          PAIR_SEPARATION * step < abs(conj.imag()))) match[single[k]] = n;
+    }
+
+    // the second zero of a clear and mutual match takes the conjugate of
+    // the first
+    bool sorted = true;
+    for (const unsigned int i : single) {
+      const unsigned int j = match[i];
+      if (i < j and j < n and match[j] == i) {
+        mirror_[i] = j;
+        mirror_[j] = i;
+        splitWidth_[i] = 0;
+        zeros_[j] = std::conj(zeros_[i]);
+        logDeriv_[j] = std::conj(logDeriv_[i]);
+        resid_[j] = resid_[i];
+        if (!bound_.empty()) bound_[j] = bound_[i];
+        conv_[j] = conv_[i];
+        zerosRe_[j] = zeros_[j].real();
+        zerosIm_[j] = zeros_[j].imag();
+      }
+      else if (mirror_[i] == i and !conv_[i] and zeros_[i].imag()) sorted = false;
+    }
+    buildRows();
+
+    return sorted;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! pair up zeros of real coeffs anew after a sweep
+  //! a pair proposed by newtonStep is split into two real zeros if p changes
+  //! sign within twice their distance from its center, where no real zero is
+  //! yet, and one that got closer to the real axis than the square root of
+  //! the precision is split anyway, so that its zeros don't coincide
+  //! a zero on its own that converged onto the second zero of a pair is
+  //! moved off it, since only it sees the other
+  //! returns the number of converged zeros
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  unsigned int ZeroFinder<T>::updatePairs()
+  {
+    const T sqrtEps = sqrt(std::numeric_limits<T>::epsilon());
+
+    // zeros not paired, by real part
+    std::vector<unsigned int> &single = invPerm_;
+    single.clear();
+    for(unsigned int i = 0; i < this->deg_; i++) {
+      if (mirror_[i] == i) single.push_back(i);
+    }
+    std::sort(single.begin(), single.end(), [this](const unsigned int v, const unsigned int w)
+        {return zeros_[v].real() < zeros_[w].real();});
+
+    // split pairs
+    for(unsigned int k = 0; k < numRows(); k++) {
+      const unsigned int i = row(k),
+                         j = mirror_[i];
+      if (j == i) continue;
+      const T x = zeros_[i].real(),
+              d = splitWidth_[i];
+      T spread = 0;
+      if (d) {
+        const bool negative = negativeAt(x);
+        auto next = std::lower_bound(single.cbegin(), single.cend(), x - 2 * d,
+            [this](const unsigned int v, const T y) {return zeros_[v].real() < y;});
+        while (next != single.cend() and zeros_[*next].real() <= x + 2 * d and
+            abs(zeros_[*next].imag()) > 2 * d) ++next;
+        if ((next == single.cend() or x + 2 * d < zeros_[*next].real()) and
+            (negativeAt(x - 2 * d) != negative or
+            negativeAt(x + 2 * d) != negative)) spread = d;
+      }
+      if (!spread and abs(zeros_[i].imag()) <= sqrtEps * abs(zeros_[i])) {
+        spread = std::max(abs(zeros_[i].imag()), sqrtEps * (1 + abs(zeros_[i])));
+      }
+
+      // a pair whose step overshot the real axis just trades places
+      if (!spread) {
+        if (zeros_[i].imag() < 0) {
+          std::swap(zeros_[i], zeros_[j]);
+          std::swap(logDeriv_[i], logDeriv_[j]);
+          zerosIm_[i] = zeros_[i].imag();
+          zerosIm_[j] = zeros_[j].imag();
+        }
+
+        // the second zero doesn't repel zeros on their own, so one that
+        // converged onto it is moved off by about its newton step, as in
+        // releasePairs
+        const T tol = sqrtEps * (1 + abs(zeros_[j]));
+        for(auto next = std::lower_bound(single.cbegin(), single.cend(), zeros_[j].real() - tol,
+            [this](const unsigned int v, const T y) {return zeros_[v].real() < y;});
+            next != single.cend() and zeros_[*next].real() <= zeros_[j].real() + tol; ++next) {
+          const unsigned int l = *next;
+          if (abs(zeros_[l] - zeros_[j]) > tol) continue;
+          const T mag = 1 + abs(zeros_[l]),
+                  step = std::min(mag, abs(static_cast<std::complex<T>>(1) / logDeriv_[l]));
+          zeros_[l] += std::polar(std::max(step, sqrtEps * mag), static_cast<T>(1));
+          compLogDeriv(l);
+          countEval(zeros_[l]);
+          zerosRe_[l] = zeros_[l].real();
+          zerosIm_[l] = zeros_[l].imag();
+          conv_[l] = 0;
+        }
+        continue;
+      }
+
+      zeros_[j] = x + spread;
+      zeros_[i] = x - spread;
+      mirror_[i] = i;
+      mirror_[j] = j;
+      for (const unsigned int l : {i, j}) {
+        compLogDeriv(l);
+        zerosRe_[l] = zeros_[l].real();
+        zerosIm_[l] = 0;
+        countEval(zeros_[l]);
+      }
+    }
+
+    buildRows();
+
+    return std::count(conv_.cbegin(), conv_.cend(), 1);
+  }
+
+  //----------------------------------------------------------------------------//
+  //! iterate zeros not yet converged on their own, as for complex coeffs,
+  //! for when pairs haven't split into as many real zeros as p has
+  //! zeros symmetric about the real axis would stay so, so real zeros and
+  //! the second zero of each pair are moved by about their newton step
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::releasePairs()
+  {
+    const T sqrtEps = sqrt(std::numeric_limits<T>::epsilon());
+    for(unsigned int i = 0; i < this->deg_; i++) {
+      if (conv_[i]) continue;
+      if (mirror_[i] < i or !zeros_[i].imag()) {
+        const T mag = 1 + abs(zeros_[i]),
+                step = std::min(mag, abs(static_cast<std::complex<T>>(1) / logDeriv_[i]));
+        zeros_[i] += std::polar(std::max(step, sqrtEps * mag), static_cast<T>(1));
+        compLogDeriv(i);
+        countEval(zeros_[i]);
+      }
+      mirror_[i] = i;
+      zerosRe_[i] = zeros_[i].real();
+      zerosIm_[i] = zeros_[i].imag();
+    }
+    buildRows();
+  }
+
+  //----------------------------------------------------------------------------//
+  //! step each cluster of zeros after a sweep, then find new clusters
+  //! near a zero of multiplicity m, m zeros close in on it only linearly,
+  //! so a cluster of m zeros is iterated as one zero of multiplicity m:
+  //! its center c moves by m / g(c), where g(c) = p'(c) / p(c) - sum_j
+  //! 1 / (c - z_j) over the zeros z_j outside the cluster, which converges
+  //! quadratically, while its zeros stay put
+  //! once p(c) passes the convergence test after a step, the zeros of the
+  //! cluster are placed about c within a few ulps of it, and clusters whose
+  //! residual |p(c)|, kept in resid_ at the first zero, doesn't halve with
+  //! each step, or that don't converge within CLUSTER_SWEEPS, are released
+  //! @param  detect  whether or not to look for new clusters
+  //! returns the number of converged zeros
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  unsigned int ZeroFinder<T>::updateClusters(const bool detect)
+  {
+    const unsigned int n = this->deg_;
+
+    // zeros of each cluster
+    std::vector<unsigned int> &members = hull_;
+
+    for(unsigned int l = 0; l < n; l++) {
+      if (cluster_[l] != l or conv_[l]) continue;
+      members.clear();
+      for(unsigned int k = l; k < n; k++) {
+        if (cluster_[k] == l) members.push_back(k);
+      }
+      const unsigned int m = members.size();
+
+      // evaluate at the center, along with the rounding error bound even
+      // if the stop criterion doesn't use it, since |p| near a multiple
+      // zero may never get below tol_
+      const std::complex<T> c = centers_[l];
+      std::complex<T> logDeriv;
+      T resid,
+        bound;
+      evalLogDeriv(c, logDeriv, resid, &bound);
+      countEval(c);
+
+      // place converged zeros on a tiny circle, so that they stay distinct
+      if (resid < tol_ or 1 <= bound) {
+        const T rad = 4 * std::numeric_limits<T>::epsilon() * (1 + abs(c)),
+                angle = std::arg(zeros_[l] - c);
+        for(unsigned int k = 0; k < m; k++) {
+          const unsigned int i = members[k];
+          zeros_[i] = c + std::polar(rad, angle + 2 * static_cast<T>(M_PI) * k / m);
+          zerosRe_[i] = zeros_[i].real();
+          zerosIm_[i] = zeros_[i].imag();
+          compLogDeriv(i);
+          conv_[i] = true;
+          countEval(zeros_[i]);
+        }
+        continue;
+      }
+
+      // step the center
+      for(unsigned int j = 0; j < n; j++) {
+        if (cluster_[j] != l) logDeriv -= static_cast<std::complex<T>>(1) / (c - zeros_[j]);
+      }
+      const std::complex<T> shift = static_cast<T>(m) / logDeriv;
+      if ((clusterAge_[l] and !(2 * resid < resid_[l])) or
+          CLUSTER_SWEEPS < ++clusterAge_[l] or !isfinite(abs(shift))) {
+        releaseCluster(l);
+        continue;
+      }
+      resid_[l] = resid;
+      centers_[l] -= shift;
+    }
+
+    if (detect) findClusters();
+    buildRows();
+
+    return std::count(conv_.cbegin(), conv_.cend(), 1);
+  }
+
+  //----------------------------------------------------------------------------//
+  //! group zeros not yet converged into clusters, or converged ones once all
+  //! have, as zeros near a multiple zero may meet a loose tol one by one
+  //! each zero z_i lies in a disc of radius r_i = n |W_i| about a zero of p,
+  //! where W_i = p(z_i) / (a_n prod_{j != i} (z_i - z_j)) is its Weierstrass
+  //! correction, and a connected component of m discs holds m zeros of p
+  //! (see getRadii), so a component of m discs that lies far from the other
+  //! zeros may approximate one zero of multiplicity m
+  //! near such a zero z, g(z_i) = p'(z_i) / p(z_i) - sum_j 1 / (z_i - z_j),
+  //! over the zeros z_j outside the component, is about m / (z_i - z),
+  //! so two zeros of the component estimate the multiplicity as
+  //! (z_i - z_k) / (1 / g(z_i) - 1 / g(z_k)), which must round to m
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::findClusters()
+  {
+    const unsigned int n = this->deg_;
+    const T logLead = log(abs(this->coeffs_.back())),
+            logDeg = log(static_cast<T>(n));
+
+    // radii of zeros that may join a cluster (0 for the others)
+    std::vector<T> &radii = logs_;
+    radii.assign(n, 0);
+    const bool all = std::count(conv_.cbegin(), conv_.cend(), 1) == n;
+    unsigned int nFree = 0;
+    for(unsigned int i = 0; i < n; i++) {
+      if (clusterWait_[i]) clusterWait_[i]--;
+      else if (cluster_[i] == n and (!conv_[i] or (all and mult_[i] == 1))) {
+        T logRad = logDeg - logLead + log(resid_[i]);
+        for(unsigned int j = 0; j < n; j++) {
+          if (j != i) logRad -= log(abs(zeros_[i] - zeros_[j]));
+        }
+        radii[i] = exp(logRad);
+        nFree++;
+      }
+    }
+    if (nFree < 2) return;
+
+    // connect overlapping discs, each zero pointing towards the first of
+    // its component
+    std::vector<unsigned int> &parent = invPerm_;
+    parent.resize(n);
+    auto find = [&parent](unsigned int i) {
+      while (parent[i] != i) i = parent[i] = parent[parent[i]];
+      return i;
+    };
+    for(unsigned int i = 0; i < n; i++) parent[i] = i;
+    for(unsigned int i = 0; i < n; i++) {
+      if (!radii[i]) continue;
+      for(unsigned int j = i + 1; j < n; j++) {
+        if (radii[j] and abs(zeros_[i] - zeros_[j]) <= radii[i] + radii[j]) {
+          const unsigned int rootI = find(i),
+                             rootJ = find(j);
+          parent[std::max(rootI, rootJ)] = std::min(rootI, rootJ);
+        }
+      }
+    }
+
+    // clusters are components of several discs at least twice their
+    // radius away from any other zero
+    std::vector<unsigned int> &members = hull_;
+    for(unsigned int l = 0; l < n; l++) {
+      if (!radii[l] or find(l) != l) continue;
+      members.clear();
+      std::complex<T> c = static_cast<T>(0);
+      for(unsigned int k = l; k < n; k++) {
+        if (radii[k] and find(k) == l) {members.push_back(k); c += zeros_[k];}
+      }
+      const unsigned int m = members.size();
+      if (m < 2) continue;
+      c /= static_cast<T>(m);
+      T rad = 0;
+      for (const unsigned int k : members) rad = std::max(rad, abs(zeros_[k] - c) + radii[k]);
+      bool isolated = isfinite(rad);
+      for(unsigned int j = 0; j < n and isolated; j++) {
+        if (!(radii[j] and find(j) == l) and abs(zeros_[j] - c) <= 2 * rad) isolated = false;
+      }
+      if (!isolated) continue;
+
+      // the first zero and the one farthest from it estimate the multiplicity
+      const unsigned int far = *std::max_element(members.cbegin(), members.cend(),
+          [this, l](const unsigned int v, const unsigned int w)
+          {return abs(zeros_[v] - zeros_[l]) < abs(zeros_[w] - zeros_[l]);});
+      std::complex<T> inv[2];
+      for (const unsigned int k : {0, 1}) {
+        const unsigned int i = k ? far : l;
+        std::complex<T> g = logDeriv_[i];
+        for(unsigned int j = 0; j < n; j++) {
+          if (!(radii[j] and find(j) == l)) g -= static_cast<std::complex<T>>(1) / (zeros_[i] - zeros_[j]);
+        }
+        inv[k] = static_cast<std::complex<T>>(1) / g;
+      }
+      const std::complex<T> mult = (zeros_[l] - zeros_[far]) / (inv[0] - inv[1]);
+      if (!(abs(mult - static_cast<T>(m)) < static_cast<T>(0.5))) continue;
+
+      for (const unsigned int k : members) {
+        cluster_[k] = l;
+        mult_[k] = m;
+        conv_[k] = false;
+      }
+      centers_[l] = c;
+      clusterAge_[l] = 0;
+    }
+  }
+
+  //----------------------------------------------------------------------------//
+  //! return the zeros of the cluster starting at l to the usual iteration,
+  //! keeping the estimated multiplicity of converged ones
+  //! zeros of a cluster that didn't converge are where it found them, and
+  //! wait a few sweeps before joining another one
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::releaseCluster(const unsigned int l)
+  {
+    const bool conv = conv_[l];
+    for(unsigned int i = l; i < this->deg_; i++) {
+      if (cluster_[i] != l) continue;
+      cluster_[i] = this->deg_;
+      if (conv) continue;
+      mult_[i] = 1;
+      clusterWait_[i] = CLUSTER_SWEEPS;
+    }
+
+    // the residual of the first zero was that of the center
+    if (!conv) compLogDeriv(l);
+    buildRows();
+  }
+
+  //----------------------------------------------------------------------------//
+  //! sort zeros by their magnitude
+  //! data of each zero are permuted along with it, and the permutation is
+  //! kept so that zeros may be tracked across updates
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::sortZeros()
+  {
+
+    // order of zeros by magnitude
+    std::vector<unsigned int> &perm = origin_;
+    perm.resize(this->deg_);
+    for(unsigned int i = 0; i < this->deg_; i++) perm[i] = i;
+    // ties are broken by imag part, so that the zero of a conjugate pair in
+    // the upper half plane comes first
+    sort(perm.begin(), perm.end(), [this](const unsigned int v, const unsigned int w)
+        {const T absV = abs(zeros_[v]), absW = abs(zeros_[w]);
+         return absV < absW or (absV == absW and zeros_[w].imag() < zeros_[v].imag());});
+
+    // apply permutation to each array by gathering into scratch space,
+    // which holds 2n reals as complex<T> is laid out as T[2]
+    auto permute = [this, &perm](auto *data, auto *buf) {
+      for(unsigned int i = 0; i < this->deg_; i++) buf[i] = data[perm[i]];
+      std::copy(buf, buf + this->deg_, data);
+    };
+    scratch_.resize(this->deg_);
+    T *buf = reinterpret_cast<T *>(scratch_.data());
+    permute(zeros_.data(), scratch_.data());
+    permute(logDeriv_.data(), scratch_.data());
+    permute(resid_.data(), buf);
+    if (!bound_.empty()) permute(bound_.data(), buf);
+    permute(conv_.data(), reinterpret_cast<unsigned char *>(scratch_.data()));
+    permute(mult_.data(), reinterpret_cast<unsigned int *>(scratch_.data()));
+
+    // conjugates move to where their pairs went
+    if (realCoeffs_) {
+      invPerm_.resize(this->deg_);
+      for(unsigned int i = 0; i < this->deg_; i++) invPerm_[perm[i]] = i;
+      unsigned int *mirrorBuf = reinterpret_cast<unsigned int *>(scratch_.data());
+      permute(mirror_.data(), mirrorBuf);
+      for(unsigned int i = 0; i < this->deg_; i++) mirror_[i] = invPerm_[mirror_[i]];
+    }
+  }
+
+  //----------------------------------------------------------------------------//
+  //! update zeros one after the other (Gauss-Seidel order)
+  //! the sum for each zero uses the zeros already updated in this sweep,
+  //! so split arrays are refreshed right after each update
+  //! returns the number of converged zeros among those iterated
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  unsigned int ZeroFinder<T>::seidelStep()
+  {
+
+    // number of converged zeros
+    unsigned int nConv = 0;
+
+    // zeros are only timed if stats are collected
+    for(unsigned int k = 0; k < numRows(); k++) {
+      if (!collectStats_) {
+        compInvDiffSum(k, k + 1);
+        nConv += newtonStep(k, k + 1);
+        splitZeros(k, k + 1);
+        continue;
+      }
+      const auto start = std::chrono::steady_clock::now();
+      compInvDiffSum(k, k + 1);
+      const auto mid = std::chrono::steady_clock::now();
+      nConv += newtonStep(k, k + 1);
+      splitZeros(k, k + 1);
+      const auto stop = std::chrono::steady_clock::now();
+      stats_.sumTime += std::chrono::duration<double>(mid - start).count();
+      stats_.stepTime += std::chrono::duration<double>(stop - mid).count();
+    }
+
+    return nConv;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! run the first iterations with a copy of this finder in float, where
+  //! vectors hold twice as many zeros, until its zeros stop moving at float
+  //! precision or half of maxIters_ are spent
+  //! its zeros then seed this finder, whose iterations polish them in T,
+  //! so converged zeros meet the same test |p| < tol_ as before
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::floatStage()
+  {
+
+    // coeffs rounded to float must still define a polynomial of this degree
+    std::vector<std::complex<float>> coeffs(this->deg_ + 1);
+    for(unsigned int i = 0; i <= this->deg_; i++) {
+      coeffs[i] = {static_cast<float>(this->coeffs_[i].real()),
+                   static_cast<float>(this->coeffs_[i].imag())};
+      if (!std::isfinite(abs(coeffs[i]))) return;
+    }
+    if (coeffs.back() == static_cast<std::complex<float>>(0)) return;
+
+    // copy settings, then start from the same guesses, which the float
+    // finder doesn't compute or evaluate for itself
+    ZeroFinder<float> finder(coeffs, std::max(static_cast<float>(tol_), FLT_MIN),
+        maxIters_ / 2, initMode_, false);
+    finder.isa_ = std::min(isa_, simd::detectIsa());
+    finder.setThreadPool(pool_);
+    finder.setSumMode(sumMode_, fmm_ ? fmm_->getTol() : 1e-6);
+    finder.activeSet_ = activeSet_;
+    finder.updateMode_ = updateMode_;
+    finder.stallTol_ = 4 * FLT_EPSILON;
+    finder.realCoeffs_ = realCoeffs_;
+    finder.mirror_ = mirror_;
+    finder.deadline_ = deadline_;
+    finder.cancelToken_ = cancelToken_;
+    finder.collectStats_ = collectStats_;
+    for(unsigned int i = 0; i < this->deg_; i++) {
+      finder.zeros_[i] = {static_cast<float>(zeros_[i].real()),
+                          static_cast<float>(zeros_[i].imag())};
+      finder.compLogDeriv(i);
+    }
+    finder.compZeros();
+
+    // statistics of float iterations count towards this solve
+    stats_.iters = finder.stats_.iters;
+    stats_.evals = finder.stats_.evals;
+    stats_.forwardEvals = finder.stats_.forwardEvals;
+    stats_.reverseEvals = finder.stats_.reverseEvals;
+    stats_.activeRows = finder.stats_.activeRows;
+    stats_.sumTime = finder.stats_.sumTime;
+    stats_.stepTime = finder.stats_.stepTime;
+
+    // keep finite zeros, restoring symmetry of pairs, then evaluate all
+    // of them in T
+    mirror_ = finder.mirror_;
+    for(unsigned int i = 0; i < this->deg_; i++) {
+      if (std::isfinite(abs(finder.zeros_[i]))) {
+        zeros_[i] = static_cast<std::complex<T>>(finder.zeros_[i]);
+      }
+      if (mirror_[i] < i) zeros_[i] = std::conj(zeros_[mirror_[i]]);
+      compLogDeriv(i);
+      conv_[i] = resid_[i] < tol_;
+      countEval(zeros_[i]);
+    }
+    iters_ = finder.iters_;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! x converted to W, exactly if W is wider: long double is split in two
+  //! doubles, as expansions only convert from double, and an expansion is
+  //! rounded to a built-in type from its two leading doubles
+  //----------------------------------------------------------------------------//
+  template <typename W, typename T>
+  static W convert(const T x)
+  {
+    if constexpr (std::is_floating_point<T>::value and !std::is_floating_point<W>::value) {
+      const double hi = static_cast<double>(x);
+      return W(hi) + W(static_cast<double>(x - hi));
+    }
+    else if constexpr (!std::is_floating_point<T>::value and std::is_floating_point<W>::value) {
+      return static_cast<W>(x[0]) + static_cast<W>(x[1]);
+    }
+    else return static_cast<W>(x);
+  }
+
+  template <typename W, typename T>
+  static std::complex<W> convert(const std::complex<T> &x)
+  {
+    return {convert<W>(x.real()), convert<W>(x.imag())};
+  }
+
+  //----------------------------------------------------------------------------//
+  //! after the iterations in T, go on with a copy of this finder in
+  //! Promoted<T>::type for the zeros that stopped at the rounding error level
+  //! of |p| short of tol_, unless their newton correction p / p' is already
+  //! within the rounding error of T, as for the well-conditioned majority
+  //! the copy holds the coeffs exactly and iterates only those zeros, with
+  //! the others frozen, so only their evaluations and sums are paid for in
+  //! the wider type, and they are rounded back to T with the residual |p|
+  //! at their unrounded value
+  //! returns why the iterations of the copy stopped
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  SolveStatus ZeroFinder<T>::promoteStage()
+  {
+    using W = typename Promoted<T>::type;
+    if constexpr (std::is_same<W, T>::value) return SolveStatus::converged;
+    else {
+
+      // zeros short of tol whose correction |p / p'| exceeds deg ulps of
+      // them, and so their conjugates, which share their residual
+      const T eps = this->deg_ * std::numeric_limits<T>::epsilon();
+      std::vector<unsigned char> &stalled = stalled_;
+      for(unsigned int i = 0; i < this->deg_; i++) {
+        stalled[i] = !(resid_[i] < tol_) and eps * abs(zeros_[i]) * abs(logDeriv_[i]) < 1;
+      }
+      if (maxIters_ <= iters_ or
+          std::find(stalled.cbegin(), stalled.cend(), 1) == stalled.cend()) {
+        return SolveStatus::converged;
+      }
+
+      // the copy is built for a polynomial of degree 1, then given the coeffs
+      // without guesses, whose evaluations would cost as much as a sweep
+      std::vector<std::complex<W>> coeffs(2, static_cast<W>(1));
+      ZeroFinder<W> finder(coeffs, convert<W>(tol_), maxIters_ - iters_, "symm");
+      coeffs.resize(this->deg_ + 1);
+      for(unsigned int i = 0; i <= this->deg_; i++) coeffs[i] = convert<W>(this->coeffs_[i]);
+      finder.setCoeffs(coeffs);
+      finder.rev_->setCoeffs(coeffs, true);
+      finder.initData(false);
+
+      // copy settings, freezing all but the stalled zeros, which stop at the
+      // rounding error level of the wider type if they can't meet tol there
+      finder.setThreadPool(pool_);
+      finder.activeSet_ = true;
+      finder.updateMode_ = updateMode_;
+      finder.stopCriterion_ = "bound";
+      finder.bound_.resize(this->deg_);
+      finder.realCoeffs_ = realCoeffs_;
+      finder.mirror_ = mirror_;
+      finder.clusterDetection_ = clusterDetection_;
+      finder.deadline_ = deadline_;
+      finder.cancelToken_ = cancelToken_;
+      finder.collectStats_ = collectStats_;
+      for(unsigned int i = 0; i < this->deg_; i++) {
+        finder.zeros_[i] = convert<W>(zeros_[i]);
+        finder.conv_[i] = !stalled[i];
+        if (stalled[i]) finder.compLogDeriv(i);
+      }
+      finder.compZeros();
+
+      // statistics of wider iterations count towards this solve
+      stats_.iters += finder.stats_.iters;
+      stats_.evals += finder.stats_.evals;
+      stats_.forwardEvals += finder.stats_.forwardEvals;
+      stats_.reverseEvals += finder.stats_.reverseEvals;
+      stats_.activeRows.insert(stats_.activeRows.end(),
+          finder.stats_.activeRows.cbegin(), finder.stats_.activeRows.cend());
+      stats_.sumTime += finder.stats_.sumTime;
+      stats_.stepTime += finder.stats_.stepTime;
+
+      // round stalled zeros back to T, undoing the sort of the copy, and
+      // take its pairs, which it may have split
+      const std::vector<unsigned int> &origin = finder.origin_;
+      for(unsigned int k = 0; k < this->deg_; k++) {
+        const unsigned int i = origin[k];
+        mirror_[i] = origin[finder.mirror_[k]];
+        if (!stalled[i]) continue;
+        zeros_[i] = convert<T>(finder.zeros_[k]);
+        logDeriv_[i] = convert<T>(finder.logDeriv_[k]);
+        resid_[i] = convert<T>(finder.resid_[k]);
+        bound_[i] = convert<T>(finder.bound_[k]);
+        conv_[i] = finder.conv_[k];
+        mult_[i] = finder.mult_[k];
+      }
+      iters_ += finder.iters_;
+      allConv_ = finder.allConv_;
+
+      return finder.stats_.status;
+    }
+  }
+
+  //----------------------------------------------------------------------------//
+  //! count evaluations at rows [0, nRows) in stats_
+  //! compLogDeriv used the polynomial at zeros inside the unit circle and
+  //! its reverse at the others, so counting after the fact keeps threads
+  //! from sharing counters
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::countEvals(const unsigned int nRows)
+  {
+    if (!collectStats_) return;
+    for(unsigned int k = 0; k < nRows; k++) {
+      if (abs(zeros_[row(k)]) < 1) stats_.forwardEvals++;
+      else stats_.reverseEvals++;
+    }
+    stats_.evals += nRows;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! count an evaluation at z in stats_, if they are collected
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::countEval(const std::complex<T> z)
+  {
+    if (!collectStats_) return;
+    if (abs(z) < 1) stats_.forwardEvals++;
+    else stats_.reverseEvals++;
+    stats_.evals++;
   }
 
   //----------------------------------------------------------------------------//
@@ -282,8 +1637,14 @@ namespace aberth
   //----------------------------------------------------------------------------//
   template class Polynomial<float>;
   template class Polynomial<double>;
+  template class Polynomial<long double>;
+  template class Polynomial<DoubleDouble>;
+  template class Polynomial<QuadDouble>;
 
   template class ZeroFinder<float>;
   template class ZeroFinder<double>;
+  template class ZeroFinder<long double>;
+  template class ZeroFinder<DoubleDouble>;
+  template class ZeroFinder<QuadDouble>;
 
 }
@@ -7,6 +7,17 @@
 #include <string>
 #include <complex>
 #include <memory>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <future>
+
+// includes, project
+#include "aberth_simd.h"
+#include "aberth_pool.h"
+#include "aberth_fmm.h"
+#include "aberth_rng.h"
+#include "aberth_dd.h"
 
 namespace aberth
 {
@@ -30,6 +41,10 @@ namespace aberth
       //! degree of polynomial
       unsigned int deg_;
 
+      //! exponents of nonzero coeffs in increasing order, if few enough that
+      //! evaluating term by term beats Horner's method (empty otherwise)
+      std::vector<unsigned int> terms_;
+
     //**************************************
     // member functions
     //**************************************
@@ -37,19 +52,165 @@ namespace aberth
     public:
 
       //! constructor
-      Polynomial(const std::vector<std::complex<T>> coeffs);
+      Polynomial(const std::vector<std::complex<T>> &coeffs);
 
       //! return coeffs
-      std::vector<std::complex<T>> getCoeffs() const ;
+      const std::vector<std::complex<T>>& getCoeffs() const ;
+
+      //! replace coeffs, in reverse order if reversed
+      void setCoeffs(const std::vector<std::complex<T>> &coeffs,
+          const bool reversed = false);
+
+      //! replace coeffs with size entries of an array, in reverse order if reversed
+      void setCoeffs(const std::complex<T> *coeffs,
+          const unsigned int size,
+          const bool reversed = false);
 
       //! use Horner's method to evaluate polynomial at x
       std::complex<T> eval(const std::complex<T> x) const;
 
+      //! evaluate polynomial and its derivative at x in one Horner pass
+      void evalDeriv(const std::complex<T> x,
+          std::complex<T> &val,
+          std::complex<T> &deriv) const;
+
+      //! evaluate polynomial and its derivative at x, both scaled by 2^-exp
+      //! along with a bound on the rounding error of val if errBound is set
+      //! imag parts of coeffs are ignored if realCoeffs
+      int evalDerivScaled(const std::complex<T> x,
+          std::complex<T> &val,
+          std::complex<T> &deriv,
+          T *errBound = nullptr,
+          const bool realCoeffs = false) const;
+
       //! compute coeffs of this polynomial's derivative
       std::vector<std::complex<T>> compDerivCoeffs() const;
 
+      //! whether or not the polynomial is evaluated term by term
+      bool isSparse() const;
+
+    protected:
+
+      //! collect exponents of nonzero coeffs into terms_ if sparse enough
+      void findTerms();
+
+      //! evaluate polynomial and its derivative at x term by term, as
+      //! evalDerivScaled does with Horner's method
+      int evalDerivSparse(const std::complex<T> x,
+          std::complex<T> &val,
+          std::complex<T> &deriv,
+          T *errBound,
+          const bool realCoeffs) const;
+
+  };
+
+  //----------------------------------------------------------------------------//
+  //! Reason a call to ZeroFinder<T>::compZeros returned
+  //----------------------------------------------------------------------------//
+  enum class SolveStatus {converged, maxIters, deadline, cancelled};
+
+  //----------------------------------------------------------------------------//
+  //! Statistics of one call to ZeroFinder<T>::compZeros
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  struct SolveStats
+  {
+
+    //! number of iterations performed
+    unsigned int iters = 0;
+
+    //! evaluations of the polynomial and its derivative
+    unsigned long evals = 0;
+
+    //! evaluations with the polynomial, at zeros inside the unit circle
+    unsigned long forwardEvals = 0;
+
+    //! evaluations with the reverse polynomial, at the other zeros
+    unsigned long reverseEvals = 0;
+
+    //! number of zeros updated in each iteration
+    std::vector<unsigned int> activeRows;
+
+    //! seconds spent computing sums of reciprocal differences
+    double sumTime = 0;
+
+    //! seconds spent in newton steps, including evaluations
+    double stepTime = 0;
+
+    //! largest residual |p| at current zeros
+    T maxResid = 0;
+
+    //! why the iterations stopped
+    SolveStatus status = SolveStatus::maxIters;
+
+  };
+
+  //----------------------------------------------------------------------------//
+  //! Zeros as left by a call to ZeroFinder<T>::compZeros, converged or not
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  struct SolveResult
+  {
+
+    //! (not necessarily converged) zeros of polynomial
+    std::vector<std::complex<T>> zeros;
+
+    //! whether or not each zero converged to within tol
+    std::vector<unsigned char> conv;
+
+    //! residual |p| at each zero
+    std::vector<T> resids;
+
+    //! number of iterations performed
+    unsigned int iters = 0;
+
+    //! why the iterations stopped
+    SolveStatus status = SolveStatus::maxIters;
+
   };
 
+  //----------------------------------------------------------------------------//
+  //! Flag shared by its copies, for cancelling solves from any thread
+  //----------------------------------------------------------------------------//
+  class CancelToken
+  {
+
+    //**************************************//
+    // data members
+    //**************************************//
+
+    protected:
+
+      //! whether or not cancel was called on any copy
+      std::shared_ptr<std::atomic<bool>> cancelled_;
+
+    //**************************************//
+    // member functions
+    //**************************************//
+
+    public:
+
+      //! default constructor, with a flag of its own
+      CancelToken() : cancelled_(std::make_shared<std::atomic<bool>>(false)) {}
+
+      //! ask solves holding a copy of this token to stop after their sweep
+      void cancel() const {cancelled_->store(true, std::memory_order_relaxed);}
+
+      //! whether or not cancel was called on any copy
+      bool isCancelled() const {return cancelled_->load(std::memory_order_relaxed);}
+
+  };
+
+  //----------------------------------------------------------------------------//
+  //! Type that zeros of a ZeroFinder<T> stalled at the rounding error of T
+  //! are promoted to in precisionMode "adaptive" (T itself if none is wider)
+  //----------------------------------------------------------------------------//
+  template <typename T> struct Promoted {using type = T;};
+  template <> struct Promoted<float> {using type = double;};
+  template <> struct Promoted<double> {using type = DoubleDouble;};
+  template <> struct Promoted<long double> {using type = QuadDouble;};
+  template <> struct Promoted<DoubleDouble> {using type = QuadDouble;};
+
   //----------------------------------------------------------------------------//
   //! Derived from Polynomial class
   //----------------------------------------------------------------------------//
@@ -82,19 +243,137 @@ namespace aberth
       bool allConv_;
 
       //! whether or not individual zeros are converged to within tol
-      std::vector<bool> conv_;
+      //! (one byte per zero so that threads may update it concurrently)
+      std::vector<unsigned char> conv_;
 
       //! summed reciprocal differences of current zeros
       std::vector<std::complex<T>> invDiffSum_;
 
-      //! instance of this polynomial's derivative
-      std::unique_ptr<Polynomial<T>> deriv_;
+      //! real and imag parts of current zeros, used by compInvDiffSum
+      std::vector<T> zerosRe_,
+                     zerosIm_;
+
+      //! instruction set level used by compInvDiffSum
+      simd::Isa isa_;
+
+      //! pool splitting the zeros across threads (serial if null)
+      std::shared_ptr<ThreadPool> pool_;
+
+      //! number of converged zeros in each chunk of the pool
+      std::vector<unsigned int> convCounts_;
+
+      //! method for computing invDiffSum
+      std::string sumMode_;
+
+      //! fast multipole engine for sumMode "fmm"
+      std::unique_ptr<CauchyFmm> fmm_;
+
+      //! whether or not converged zeros are frozen
+      bool activeSet_;
+
+      //! indices of zeros not yet converged, iterated if activeSet_
+      std::vector<unsigned int> active_;
+
+      //! order of updates within a sweep ("jacobi" or "seidel")
+      std::string updateMode_;
+
+      //! logarithmic derivative p' / p at current zeros
+      std::vector<std::complex<T>> logDeriv_;
+
+      //! |p| at current zeros
+      std::vector<T> resid_;
 
       //! instance of this polynomial's reverse
       std::unique_ptr<Polynomial<T>> rev_;
 
-      //! instance of the derivative of this polynomial's reverse
-      std::unique_ptr<Polynomial<T>> revDeriv_;
+      //! precision of iterations ("full", "mixed" to start in float, or
+      //! "adaptive" to finish stalled zeros in Promoted<T>::type)
+      std::string precisionMode_;
+
+      //! zeros whose correction is at most stallTol_ times their magnitude
+      //! are also converged (off if 0)
+      T stallTol_;
+
+      //! test for convergence ("tol", or "bound" to also stop at the rounding
+      //! error level of |p|)
+      std::string stopCriterion_;
+
+      //! bound on rounding error of p relative to |p| at current zeros
+      //! (empty unless stopCriterion_ is "bound" or precisionMode_ "adaptive")
+      std::vector<T> bound_;
+
+      //! index each zero had before the last sort
+      std::vector<unsigned int> origin_;
+
+      //! statistics of the current or last call to compZeros
+      SolveStats<T> stats_;
+
+      //! whether or not times, evaluations and active rows are collected
+      bool collectStats_;
+
+      //! called after each iteration with the statistics so far (off if null)
+      std::function<void(const SolveStats<T> &)> iterCallback_;
+
+      //! whether or not coeffs are real, so that zeros are iterated in
+      //! conjugate pairs
+      bool realCoeffs_;
+
+      //! index of each zero's conjugate, if realCoeffs_ (itself if unpaired)
+      std::vector<unsigned int> mirror_;
+
+      //! half width of the real zeros each pair would split into, as
+      //! proposed by newtonStep for updatePairs to check (0 if none), and
+      //! length of the last step of each zero on its own, for pairZeros
+      std::vector<T> splitWidth_;
+
+      //! zeros are only paired up once each is this many times closer to
+      //! the conjugate of its match than any other zero is
+      static constexpr unsigned int PAIR_SEPARATION = 4;
+
+      //! sweeps a cluster may take to converge, and sweeps the zeros of one
+      //! that didn't must wait before joining another
+      static constexpr unsigned int CLUSTER_SWEEPS = 8;
+
+      //! whether or not clusters of zeros are detected and iterated as
+      //! multiple zeros
+      bool clusterDetection_;
+
+      //! index of the first zero of each zero's cluster (deg if unclustered)
+      std::vector<unsigned int> cluster_;
+
+      //! estimated multiplicity of the zero each zero approximates
+      std::vector<unsigned int> mult_;
+
+      //! center of each cluster, at its first zero
+      std::vector<std::complex<T>> centers_;
+
+      //! sweeps each cluster has been iterated, at its first zero, and
+      //! sweeps each zero must wait before joining another cluster
+      std::vector<unsigned int> clusterAge_,
+                                clusterWait_;
+
+      //! stream of random numbers for "rand" and "symm" guesses
+      SplitMix rng_;
+
+      //! sweeps stop once this time has passed (never if max)
+      std::chrono::steady_clock::time_point deadline_;
+
+      //! sweeps stop once this is cancelled
+      CancelToken cancelToken_;
+
+      //! scratch buffers kept between solves to avoid allocation, whose
+      //! contents are never reused (so not copied)
+      std::vector<unsigned int> hull_,
+                                invPerm_;
+      std::vector<T> logs_,
+                     draws_;
+      std::vector<std::complex<T>> scratch_;
+
+      //! zeros that promoteStage finishes in a wider type
+      std::vector<unsigned char> stalled_;
+
+      //! finders of other precisions seed and polish this one
+      template <typename U> friend class ZeroFinder;
 
 
     //**************************************//
@@ -104,7 +383,7 @@ namespace aberth
     public:
 
       //! non-default constructor
-      ZeroFinder(const std::vector<std::complex<T>> coeffs,
+      ZeroFinder(const std::vector<std::complex<T>> &coeffs,
           const T tol = 1e-9,
           const unsigned int maxIters = 200,
           const std::string initMode = "rand");
@@ -128,12 +407,108 @@ namespace aberth
       bool compZeros(const bool verbose = false);
 
       //! return (not necessarily converged) zeros of polynomial
-      std::vector<std::complex<T>> getZeros() const;
+      const std::vector<std::complex<T>>& getZeros() const;
+
+      //! start over with a polynomial given by size coeffs, reusing buffers
+      void reset(const std::complex<T> *coeffs, const unsigned int size);
+
+      //! start over as reset does, drawing guesses from the stream of seed
+      void reset(const std::complex<T> *coeffs, const unsigned int size, const uint64_t seed);
+
+      //! replace coeffs, keeping zeros as guesses for the next compZeros
+      void update(const std::vector<std::complex<T>> &coeffs);
+
+      //! return index each zero had in getZeros before the last compZeros
+      const std::vector<unsigned int>& getOrigins() const;
+
+      //! select instruction set level used by compInvDiffSum
+      void setIsa(const simd::Isa isa);
+
+      //! return instruction set level used by compInvDiffSum
+      simd::Isa getIsa() const;
+
+      //! iterate with a new pool of nThreads threads (serial if nThreads <= 1)
+      void setNumThreads(const unsigned int nThreads);
+
+      //! iterate with an existing pool (serial if null)
+      void setThreadPool(std::shared_ptr<ThreadPool> pool);
+
+      //! select method for computing invDiffSum ("exact" or "fmm")
+      void setSumMode(const std::string sumMode, const double fmmTol = 1e-6);
+
+      //! whether or not to stop updating converged zeros
+      void setActiveSet(const bool activeSet);
+
+      //! select order of updates within a sweep ("jacobi" or "seidel")
+      void setUpdateMode(const std::string updateMode);
+
+      //! select precision of iterations ("full", "mixed" or "adaptive")
+      void setPrecisionMode(const std::string precisionMode);
+
+      //! whether or not to iterate zeros of real coeffs in conjugate pairs
+      void setRealCoeffs(const bool realCoeffs);
+
+      //! whether or not to iterate clusters of zeros as multiple zeros
+      void setClusterDetection(const bool clusterDetection);
+
+      //! return estimated multiplicity of the zero each zero approximates
+      const std::vector<unsigned int>& getMultiplicities() const;
+
+      //! select test for convergence ("tol" or "bound")
+      void setStopCriterion(const std::string stopCriterion);
+
+      //! draw "rand" and "symm" guesses anew from the stream of seed
+      void setSeed(const uint64_t seed);
+
+      //! return radii of discs about the zeros whose union holds all zeros
+      std::vector<T> getRadii() const;
+
+      //! return number of iterations performed
+      unsigned int getIters() const;
+
+      //! return statistics of the last call to compZeros
+      const SolveStats<T>& getStats() const;
+
+      //! whether or not to collect times, evaluations and active rows
+      void setStats(const bool stats);
+
+      //! call callback after each iteration (none if null)
+      void setIterCallback(std::function<void(const SolveStats<T> &)> callback);
+
+      //! stop iterating once deadline has passed
+      void setDeadline(const std::chrono::steady_clock::time_point deadline);
+
+      //! stop iterating once token is cancelled
+      void setCancelToken(const CancelToken &token);
+
+      //! return whether or not each zero converged to within tol
+      const std::vector<unsigned char>& getConv() const;
+
+      //! return residual |p| at each zero
+      const std::vector<T>& getResids() const;
+
+      //! return zeros, with their convergence and residuals, and why the last
+      //! compZeros stopped
+      SolveResult<T> getResult() const;
+
+      //! run compZeros on another thread until converged, maxIters, deadline,
+      //! or token is cancelled, for this solve only
+      std::future<SolveResult<T>> compZerosAsync(
+          const std::chrono::steady_clock::time_point deadline =
+            std::chrono::steady_clock::time_point::max(),
+          const CancelToken &token = CancelToken());
 
     protected:
 
-      //! initialize data
-      void initData();
+      //! constructor for finders whose zeros are set by another
+      ZeroFinder(const std::vector<std::complex<T>> &coeffs,
+          const T tol,
+          const unsigned int maxIters,
+          const std::string initMode,
+          const bool guess);
+
+      //! initialize data, with guesses unless another finder sets the zeros
+      void initData(const bool guess = true);
 
       //! compute initial guesses for zeros
       void initZeros();
@@ -141,11 +516,286 @@ namespace aberth
       //! get upper bound on magnitude of zeros
       T compBound() const;
 
-      //! compute invDiffSum elts
-      void compInvDiffSum();
+      //! compute initial guesses from the newton polygon
+      void newtonPolygonZeros();
+
+      //! place m guesses on a circle, starting with the ith zero
+      void circleZeros(const unsigned int i,
+          const unsigned int m,
+          const T r,
+          const T angle);
+
+      //! collect the zeros to iterate in each sweep
+      void buildRows();
+
+      //! whether p is negative at a real point, for real coeffs
+      bool negativeAt(const T x);
+
+      //! pair up zeros of real coeffs whose conjugates are clear, returning
+      //! whether or not all zeros left off the real axis are paired
+      bool pairZeros();
+
+      //! pair up zeros of real coeffs anew, returning number converged
+      unsigned int updatePairs();
+
+      //! iterate zeros not yet converged on their own
+      void releasePairs();
+
+      //! number of zeros iterated in each sweep
+      unsigned int numRows() const;
+
+      //! index of the kth zero iterated in each sweep
+      unsigned int row(const unsigned int k) const;
+
+      //! copy rows [begin, end) of zeros to real and imag arrays
+      void splitZeros(const unsigned int begin, const unsigned int end);
+
+      //! compute invDiffSum elts for rows [begin, end)
+      void compInvDiffSum(const unsigned int begin, const unsigned int end);
+
+      //! evaluate logarithmic derivative and residual at the ith zero
+      void compLogDeriv(const unsigned int i);
+
+      //! evaluate logarithmic derivative and residual at z
+      void evalLogDeriv(const std::complex<T> z,
+          std::complex<T> &logDeriv,
+          T &resid,
+          T *bound) const;
+
+      //! step clusters, then find new ones if detect, returning number converged
+      unsigned int updateClusters(const bool detect);
+
+      //! group zeros not yet converged, or all once they are, into clusters
+      void findClusters();
+
+      //! return zeros of the cluster starting at l to the usual iteration
+      void releaseCluster(const unsigned int l);
+
+      //! sort zeros and their data by magnitude
+      void sortZeros();
+
+      //! update rows [begin, end) of zeros with a Newton step
+      unsigned int newtonStep(const unsigned int begin, const unsigned int end);
+
+      //! update zeros one after the other, each using the latest zeros
+      unsigned int seidelStep();
+
+      //! run the first iterations in float, then evaluate results in T
+      void floatStage();
+
+      //! iterate zeros stalled at the rounding error of T in a wider type
+      SolveStatus promoteStage();
+
+      //! count evaluations at rows [0, nRows), made by newtonStep
+      void countEvals(const unsigned int nRows);
+
+      //! count an evaluation at z, if stats are collected
+      void countEval(const std::complex<T> z);
+
+  };
+
+  //----------------------------------------------------------------------------//
+  //! Solve a batch of polynomials sharing the same degree
+  //! data are stored as split real/imag arrays, interleaved in tiles of
+  //! BATCH_TILE polynomials so that each step runs across a tile at once
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  class BatchZeroFinder
+  {
+
+    //**************************************//
+    // data members
+    //**************************************//
+
+    public:
+
+      //! number of polynomials iterated together
+      static constexpr unsigned int BATCH_TILE = 16;
+
+    protected:
+
+      //! number of polynomials in batch
+      unsigned int batch_;
+
+      //! number of tiles (last tile is padded)
+      unsigned int tiles_;
+
+      //! common degree of polynomials
+      unsigned int deg_;
+
+      //! tolerance for calculation
+      T tol_;
+
+      //! maximum number of iterations
+      unsigned int maxIters_;
+
+      //! method for initializing zeros
+      std::string initMode_;
+
+      //! real and imag parts of coeffs
+      std::vector<T> coeffsRe_,
+                     coeffsIm_;
+
+      //! real and imag parts of (not necessarily converged) zeros
+      std::vector<T> zerosRe_,
+                     zerosIm_;
+
+      //! real and imag parts of summed reciprocal differences of zeros
+      std::vector<T> invDiffSumRe_,
+                     invDiffSumIm_;
+
+      //! whether or not individual zeros are converged to within tol
+      std::vector<unsigned char> conv_;
+
+      //! whether or not all zeros of each polynomial are converged
+      std::vector<unsigned char> polyConv_;
+
+      //! number of iterations performed for each polynomial
+      std::vector<unsigned int> iters_;
+
+      //! stream of random numbers for guesses
+      SplitMix rng_;
+
+    //**************************************//
+    // member functions
+    //**************************************//
+
+    public:
+
+      //! non-default constructor
+      BatchZeroFinder(const std::vector<std::vector<std::complex<T>>> &coeffs,
+          const T tol = 1e-9,
+          const unsigned int maxIters = 200,
+          const std::string initMode = "rand");
+
+      //! use Aberth's method to approximate zeros of every polynomial
+      bool compZeros(const bool verbose = false);
+
+      //! return (not necessarily converged) zeros of the bth polynomial
+      std::vector<std::complex<T>> getZeros(const unsigned int b) const;
+
+      //! whether or not all zeros of the bth polynomial converged
+      bool getConv(const unsigned int b) const;
+
+      //! number of iterations performed for the bth polynomial
+      unsigned int getIters(const unsigned int b) const;
+
+      //! number of polynomials in batch
+      unsigned int size() const;
+
+      //! draw guesses anew from the stream of seed
+      void setSeed(const uint64_t seed);
+
+    protected:
+
+      //! offset of kth entry of the bth polynomial in an array of length len
+      unsigned int index(const unsigned int b,
+          const unsigned int k,
+          const unsigned int len) const;
+
+      //! compute initial guesses for zeros
+      void initZeros();
+
+      //! compute invDiffSum elts for one tile
+      void compInvDiffSum(const unsigned int tile);
+
+      //! update zeros of one tile with a Newton step
+      void newtonStep(const unsigned int tile);
+
+  };
+
+  //----------------------------------------------------------------------------//
+  //! Solve a batch of polynomials of any degrees on a WorkStealingPool
+  //! polynomials are dealt out to threads by decreasing estimated cost, and
+  //! those of degree at least splitDeg spread their sweeps over the threads
+  //! that are free, so a few large polynomials don't leave threads idle
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  class MixedBatchZeroFinder
+  {
+
+    //**************************************//
+    // data members
+    //**************************************//
+
+    protected:
+
+      //! coeffs of each polynomial
+      std::vector<std::vector<std::complex<T>>> coeffs_;
+
+      //! tolerance for calculation
+      T tol_;
+
+      //! maximum number of iterations
+      unsigned int maxIters_;
+
+      //! method for initializing zeros
+      std::string initMode_;
+
+      //! pool solving the polynomials
+      std::shared_ptr<WorkStealingPool> pool_;
+
+      //! smallest degree of polynomials whose sweeps are split over threads
+      unsigned int splitDeg_;
+
+      //! finder of each thread, reused from one polynomial to the next
+      std::vector<std::unique_ptr<ZeroFinder<T>>> finders_;
+
+      //! stream whose bth draw seeds the guesses of the bth polynomial
+      SplitMix rng_;
+
+      //! (not necessarily converged) zeros of each polynomial
+      std::vector<std::vector<std::complex<T>>> zeros_;
+
+      //! whether or not all zeros of each polynomial converged
+      std::vector<unsigned char> conv_;
+
+      //! number of iterations performed for each polynomial
+      std::vector<unsigned int> iters_;
+
+    //**************************************//
+    // member functions
+    //**************************************//
+
+    public:
+
+      //! non-default constructor
+      MixedBatchZeroFinder(const std::vector<std::vector<std::complex<T>>> &coeffs,
+          const T tol = 1e-9,
+          const unsigned int maxIters = 200,
+          const std::string initMode = "newton");
+
+      //! solve with a new pool of nThreads threads
+      void setNumThreads(const unsigned int nThreads);
+
+      //! solve with an existing pool
+      void setThreadPool(std::shared_ptr<WorkStealingPool> pool);
+
+      //! split sweeps of polynomials of degree at least splitDeg over threads
+      void setSplitDegree(const unsigned int splitDeg);
+
+      //! draw guesses of every polynomial from streams derived from seed
+      void setSeed(const uint64_t seed);
+
+      //! use Aberth's method to approximate zeros of every polynomial
+      bool compZeros();
+
+      //! return (not necessarily converged) zeros of the bth polynomial
+      const std::vector<std::complex<T>>& getZeros(const unsigned int b) const;
+
+      //! whether or not all zeros of the bth polynomial converged
+      bool getConv(const unsigned int b) const;
+
+      //! number of iterations performed for the bth polynomial
+      unsigned int getIters(const unsigned int b) const;
+
+      //! number of polynomials in batch
+      unsigned int size() const;
+
+    protected:
 
-      //! update zeros with a Newton step
-      void newtonStep();
+      //! estimated cost of solving the bth polynomial
+      double compCost(const unsigned int b) const;
 
   };
 }
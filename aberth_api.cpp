@@ -5,9 +5,15 @@
 #include <complex>
 #include <memory>
 #include <cfloat>
+#include <limits>
 #include <algorithm>
+#include <type_traits>
+#include <cmath>
+#include <cstdio>
+#include <chrono>
 
 #include "aberth.h"
+#include "aberth_simd.h"
 
 namespace aberth
 {
@@ -16,39 +22,60 @@ namespace aberth
   //! non-default constructor
   //----------------------------------------------------------------------------//
   template <typename T>
-  ZeroFinder<T>::ZeroFinder(const std::vector<std::complex<T>> coeffs,
+  ZeroFinder<T>::ZeroFinder(const std::vector<std::complex<T>> &coeffs,
       const T tol,
       const unsigned int maxIters,
       const std::string initMode) :
+    ZeroFinder(coeffs, tol, maxIters, initMode, true)
+  {}
+
+  //----------------------------------------------------------------------------//
+  //! constructor for finders whose zeros are set by another, which skip the
+  //! guesses and their evaluations if !guess
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  ZeroFinder<T>::ZeroFinder(const std::vector<std::complex<T>> &coeffs,
+      const T tol,
+      const unsigned int maxIters,
+      const std::string initMode,
+      const bool guess) :
     Polynomial<T>::Polynomial(coeffs), // call base class constructor
     tol_(tol),
     maxIters_(maxIters),
-    initMode_(initMode)
+    initMode_(initMode),
+    isa_(simd::detectIsa()),
+    sumMode_("exact"),
+    activeSet_(false),
+    updateMode_("jacobi"),
+    precisionMode_("full"),
+    stallTol_(0),
+    stopCriterion_("tol"),
+    collectStats_(false),
+    realCoeffs_(false),
+    clusterDetection_(false),
+    deadline_(std::chrono::steady_clock::time_point::max())
   {
 
     // degree must be at least 1
     assert(2 <= coeffs.size() and "Degree of polynomial must be at least 1");
 
-    // tolerance must be above smallest positive double
-    assert(DBL_MIN <= tol and "tol must be at least DBL_MIN");
-
-    // only two methods of initializing zeros 
-    assert((initMode == "rand" or initMode == "symm") and
-        "initMode must be either 'rand' or 'symm'");
+    // tolerance must be above smallest positive normal T
+    assert(std::numeric_limits<T>::min() <= tol and "tol must be at least the smallest normal T");
 
-    // initialize data
-    initData();
+    // only three methods of initializing zeros
+    assert((initMode == "rand" or initMode == "symm" or initMode == "newton") and
+        "initMode must be either 'rand', 'symm' or 'newton'");
 
-    // initialize pointer to the polynomial's derivative
-    deriv_ = std::make_unique<Polynomial<T>>(this->compDerivCoeffs());
-
-    // instantiate reverse polynomial and its derivative
+    // instantiate reverse polynomial, whose derivative is evaluated along
+    // with it
     std::vector<std::complex<T>> revCoeffs(coeffs.size());
     for(unsigned int i = 0; i < coeffs.size(); i++) {
       revCoeffs[i] = coeffs[coeffs.size() - 1 - i];
     }
     rev_ = std::make_unique<Polynomial<T>>(revCoeffs);
-    revDeriv_ = std::make_unique<Polynomial<T>>(rev_->compDerivCoeffs());
+
+    // initialize data
+    initData(guess);
   }
   
   //----------------------------------------------------------------------------//
@@ -60,41 +87,189 @@ namespace aberth
   bool ZeroFinder<T>::compZeros(const bool verbose)
   {
 
-    // run until converged or maxIters is reached
+    // number of converged zeros
+    unsigned int nConv = 0;
+
+    // gauss-seidel sweeps are serial and always use exact sums
+    const bool seidel = updateMode_ == "seidel";
+
+    // statistics of this solve, keeping the storage of activeRows
+    std::vector<unsigned int> activeRows = std::move(stats_.activeRows);
+    activeRows.clear();
+    stats_ = SolveStats<T>();
+    stats_.activeRows = std::move(activeRows);
+
+    // bulk of the iterations in float, unless this finder already started
+    if (precisionMode_ == "mixed" and !iters_ and !allConv_ and
+        !std::is_same<T, float>::value) floatStage();
+
+    // all zeros are split once here, then frozen ones are left alone
+    buildRows();
+    for(unsigned int i = 0; i < this->deg_; i++) {
+      zerosRe_[i] = zeros_[i].real();
+      zerosIm_[i] = zeros_[i].imag();
+    }
+    if (activeSet_) nConv = std::count(conv_.cbegin(), conv_.cend(), 1);
+
+    // with real coeffs, zeros are iterated on their own until they can be
+    // paired up, unless they already all are
+    bool pairing = false;
+    for(unsigned int i = 0; i < this->deg_; i++) {
+      if (realCoeffs_ and mirror_[i] == i and zeros_[i].imag()) pairing = true;
+    }
+
+    // converged zeros after the last sweep with pairs, and number of sweeps
+    // since that went up
+    unsigned int pairedConv = 0,
+                 stalled = 0;
+
+    // clusters are only looked for once zeros stop converging
+    const bool clusters = clusterDetection_ and !realCoeffs_;
+    unsigned int lastConv = nConv;
+
+    // run until converged or maxIters is reached, or until stopped early,
+    // leaving the zeros so far to resume from
+    SolveStatus status = SolveStatus::maxIters;
+    const bool timed = deadline_ != std::chrono::steady_clock::time_point::max();
+
+    // phases are only timed if stats are collected
+    auto clock = [this] {
+      return collectStats_ ? std::chrono::steady_clock::now() :
+        std::chrono::steady_clock::time_point();
+    };
     for(; iters_ < maxIters_ and !allConv_; iters_++) {
+      if (cancelToken_.isCancelled()) {status = SolveStatus::cancelled; break;}
+      if (timed and deadline_ <= std::chrono::steady_clock::now()) {
+        status = SolveStatus::deadline;
+        break;
+      }
+
+      // approximate sums are used until half of the zeros have converged
+      const bool approx = fmm_ and 2 * nConv < this->deg_;
+
+      // number of zeros updated in this sweep
+      const unsigned int nRows = numRows();
+
+      // compute diffSum then update zeros, timing each phase if needed
+      std::chrono::steady_clock::time_point start, mid;
+      if (seidel) nConv = this->deg_ - nRows + seidelStep();
+      else if (pool_) {
 
-      // compute diffSum then update zeros
-      compInvDiffSum();
-      newtonStep();
+        // each phase completes on every thread before the next one starts,
+        // so the Jacobi sweep is the same as the serial one
+        start = clock();
+        pool_->parallelFor(nRows, [this](const unsigned int b,
+              const unsigned int e, const unsigned int) {splitZeros(b, e);});
+        if (approx) fmm_->compSums(zerosRe_.data(), zerosIm_.data(), this->deg_,
+            invDiffSum_.data());
+        else pool_->parallelFor(nRows, [this](const unsigned int b,
+              const unsigned int e, const unsigned int) {compInvDiffSum(b, e);});
+        mid = clock();
+        pool_->parallelFor(nRows, [this](const unsigned int b,
+              const unsigned int e, const unsigned int c)
+            {convCounts_[c] = newtonStep(b, e);});
+
+        // reduce number of converged zeros over chunks
+        nConv = this->deg_ - nRows;
+        for (const unsigned int countI : convCounts_) nConv += countI;
+      }
+      else {
+        start = clock();
+        splitZeros(0, nRows);
+        if (approx) fmm_->compSums(zerosRe_.data(), zerosIm_.data(), this->deg_,
+            invDiffSum_.data());
+        else compInvDiffSum(0, nRows);
+        mid = clock();
+        nConv = this->deg_ - nRows + newtonStep(0, nRows);
+      }
+      if (collectStats_) {
+        if (!seidel) {
+          stats_.sumTime += std::chrono::duration<double>(mid - start).count();
+          stats_.stepTime += std::chrono::duration<double>(clock() - mid).count();
+        }
+        countEvals(nRows);
+        stats_.activeRows.push_back(nRows);
+      }
+      stats_.iters++;
+
+      // drop newly converged zeros from the active set, splitting them one
+      // last time since newtonStep moved them after this sweep's splitZeros
+      if (activeSet_) {
+        unsigned int kept = 0;
+        for (const unsigned int i : active_) {
+          if (conv_[i]) {
+            for (const unsigned int j : {i, mirror_[i]}) {
+              zerosRe_[j] = zeros_[j].real();
+              zerosIm_[j] = zeros_[j].imag();
+            }
+          }
+          else active_[kept++] = i;
+        }
+        active_.resize(kept);
+      }
+
+      // zeros of clusters weren't counted, and clusters may change
+      // clusters are looked for once zeros stop converging, or all have
+      if (clusters) {
+        const bool detect = nConv <= lastConv or nConv == this->deg_;
+        lastConv = nConv = updateClusters(detect);
+      }
+
+      // only one zero of each pair was counted, and pairs may change
+      // zeros are paired as they sort themselves out, and pairs are given up
+      // for good once zeros stop converging for a few sweeps after all zeros
+      // left off the real axis are paired
+      if (realCoeffs_) {
+        const bool sorted = pairing ? pairZeros() : true;
+        nConv = updatePairs();
+        stalled = !sorted or !nConv or pairedConv < nConv ? 0 : stalled + 1;
+        pairedConv = nConv;
+        if (stalled == 2) {
+          releasePairs();
+          pairing = false;
+        }
+      }
 
       // determine if all zeros have been converged
-      allConv_ = true;
-      for(const bool convI : conv_) {if (!convI) {allConv_ = false; break;};}
+      allConv_ = nConv == this->deg_;
+
+      // report progress, only paying for the residuals if anyone listens
+      if (iterCallback_) {
+        stats_.maxResid = *std::max_element(resid_.cbegin(), resid_.cend());
+        iterCallback_(stats_);
+      }
     }
 
-    // sort zeros by their magnitude
-    sort(zeros_.begin(), zeros_.end(), [](const auto v, const auto w)
-        {return abs(v) < abs(w);});
+    // zeros of clusters go back to the usual iteration for later solves
+    if (clusters) {
+      for(unsigned int i = 0; i < this->deg_; i++) {
+        if (cluster_[i] == i) releaseCluster(i);
+      }
+    }
+
+    // zeros stalled at the rounding error of T are finished in a wider type
+    if (precisionMode_ == "adaptive" and allConv_) status = promoteStage();
 
-    // print error message if not all zeros have converged
-    if (iters_ == maxIters_ and !allConv_)
-      printf("Failed to converge all zeros after maximum (%u) iterations\n",
-             maxIters_);
+    // sort zeros by their magnitude
+    sortZeros();
+    stats_.maxResid = *std::max_element(resid_.cbegin(), resid_.cend());
+    stats_.status = allConv_ ? SolveStatus::converged : status;
 
     // if requested, print verbose output
     if (verbose) {
 
-      // obtain maximum error and index at which it occured
-      T err = 0, maxErr = 0;
-      unsigned int errInd = 0, maxInd = 0;
-      for (auto zerosI : zeros_) {
-        err = static_cast<T>(abs(this->eval(zerosI)));
-        if (maxErr < err) {maxErr = err; maxInd = errInd;}
-        errInd++;
-      }
+      // print error message if not all zeros have converged
+      if (iters_ == maxIters_ and !allConv_)
+        printf("Failed to converge all zeros after maximum (%u) iterations\n",
+               maxIters_);
+
+      // maximum error and index at which it occured
+      // residuals were evaluated at the final zeros without overflow
+      const unsigned int maxInd = std::max_element(resid_.cbegin(), resid_.cend()) -
+        resid_.cbegin();
       printf("Iterations performed = %u\n", iters_);
       printf("Index of max error   = %u\n", maxInd);
-      printf("Max error            = %.15f\n", maxErr);
+      printf("Max error            = %.15f\n", static_cast<double>(stats_.maxResid));
     }
 
     return allConv_;
@@ -104,15 +279,427 @@ namespace aberth
   //! return zeros of polynomial
   //----------------------------------------------------------------------------//
   template <typename T>
-  std::vector<std::complex<T>> ZeroFinder<T>::getZeros() const {return zeros_;}
+  const std::vector<std::complex<T>>& ZeroFinder<T>::getZeros() const {return zeros_;}
+
+  //----------------------------------------------------------------------------//
+  //! start over with a new polynomial, as if newly constructed with the
+  //! same settings
+  //! buffers only grow, so a stream of polynomials whose degrees don't
+  //! exceed the largest seen so far is solved without heap allocation
+  //! (except in precisionMode "mixed", which builds a float finder, or
+  //! "adaptive", which builds a wider one once zeros stall)
+  //! @param  coeffs  coeffs, from constant to leading
+  //! @param  size    number of coeffs
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::reset(const std::complex<T> *coeffs, const unsigned int size)
+  {
+    assert(2 <= size and "Degree of polynomial must be at least 1");
+
+    this->setCoeffs(coeffs, size);
+    rev_->setCoeffs(coeffs, size, true);
+    initData();
+  }
+
+  //----------------------------------------------------------------------------//
+  //! start over with a new polynomial, drawing guesses from the stream of
+  //! seed, which setSeed after reset would do at the cost of a second init
+  //! @param  coeffs  coeffs, from constant to leading
+  //! @param  size    number of coeffs
+  //! @param  seed    seed of stream
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::reset(const std::complex<T> *coeffs, const unsigned int size,
+      const uint64_t seed)
+  {
+    rng_.seed(seed);
+    reset(coeffs, size);
+  }
+
+  //----------------------------------------------------------------------------//
+  //! replace coeffs with those of a polynomial of the same degree
+  //! the current zeros are kept as initial guesses, so that the next
+  //! compZeros on a slightly changed polynomial needs only a few iterations
+  //! @param  coeffs  new coeffs
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::update(const std::vector<std::complex<T>> &coeffs)
+  {
+    assert(coeffs.size() == this->deg_ + 1 and "Degree of polynomial must not change");
+    assert((!realCoeffs_ or std::all_of(coeffs.cbegin(), coeffs.cend(),
+            [](const std::complex<T> c) {return !c.imag();})) and
+        "coeffs must be real if realCoeffs");
+
+    this->setCoeffs(coeffs);
+    rev_->setCoeffs(coeffs, true);
+
+    // evaluate at current zeros, none of which is converged yet
+    std::fill(conv_.begin(), conv_.end(), false);
+    std::fill(mult_.begin(), mult_.end(), 1);
+    for(unsigned int i = 0; i < this->deg_; i++) compLogDeriv(i);
+    iters_ = 0;
+    allConv_ = false;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! return index each zero had in getZeros before the last compZeros
+  //! after update, the ith zero came from the origins[i]th zero of the
+  //! previous polynomial
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  const std::vector<unsigned int>& ZeroFinder<T>::getOrigins() const {return origin_;}
+
+  //----------------------------------------------------------------------------//
+  //! select instruction set level used by compInvDiffSum
+  //! @param  isa  level no higher than the one supported by this cpu
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::setIsa(const simd::Isa isa)
+  {
+    assert(isa <= simd::detectIsa() and "isa must be supported by this cpu");
+    isa_ = isa;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! return instruction set level used by compInvDiffSum
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  simd::Isa ZeroFinder<T>::getIsa() const {return isa_;}
+
+  //----------------------------------------------------------------------------//
+  //! iterate with a new pool of threads
+  //! @param  nThreads  number of threads (iteration is serial if at most 1)
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::setNumThreads(const unsigned int nThreads)
+  {
+    setThreadPool(1 < nThreads ? std::make_shared<ThreadPool>(nThreads) : nullptr);
+  }
+
+  //----------------------------------------------------------------------------//
+  //! iterate with an existing pool, which may be shared with other finders
+  //! @param  pool  pool of threads (iteration is serial if null)
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::setThreadPool(std::shared_ptr<ThreadPool> pool)
+  {
+    pool_ = pool;
+    convCounts_.assign(pool_ ? pool_->size() : 0, 0);
+  }
+
+  //----------------------------------------------------------------------------//
+  //! select method for computing invDiffSum
+  //! "fmm" approximates the sums with a fast multipole method in O(n) per
+  //! iteration, then switches to exact sums once half of the zeros converged
+  //! @param  sumMode  either "exact" or "fmm"
+  //! @param  fmmTol   relative accuracy of approximate sums
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::setSumMode(const std::string sumMode, const double fmmTol)
+  {
+    assert((sumMode == "exact" or sumMode == "fmm") and
+        "sumMode must be either 'exact' or 'fmm'");
+
+    sumMode_ = sumMode;
+    fmm_ = sumMode == "fmm" ? std::make_unique<CauchyFmm>(fmmTol) : nullptr;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! whether or not to stop updating converged zeros
+  //! frozen zeros still contribute to the sums of the others, so a sweep
+  //! costs O(active * n) rather than O(n^2)
+  //! @param  activeSet  if true, converged zeros are frozen
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::setActiveSet(const bool activeSet) {activeSet_ = activeSet;}
+
+  //----------------------------------------------------------------------------//
+  //! select order of updates within a sweep
+  //! "jacobi" computes all sums from the previous sweep's zeros, while
+  //! "seidel" uses each updated zero right away, which usually takes fewer
+  //! sweeps but is serial and ignores sumMode "fmm"
+  //! @param  updateMode  either "jacobi" or "seidel"
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::setUpdateMode(const std::string updateMode)
+  {
+    assert((updateMode == "jacobi" or updateMode == "seidel") and
+        "updateMode must be either 'jacobi' or 'seidel'");
+    updateMode_ = updateMode;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! select precision of iterations
+  //! "mixed" runs the first iterations in float until the zeros stop moving,
+  //! then polishes them in T, so iterations count in both precisions
+  //! "adaptive" iterates in T, where zeros also stop at the rounding error
+  //! level of |p|, then iterates those of them short of tol and not yet
+  //! accurate to T in Promoted<T>::type, leaving the others in T
+  //! @param  precisionMode  either "full", "mixed" or "adaptive"
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::setPrecisionMode(const std::string precisionMode)
+  {
+    assert((precisionMode == "full" or precisionMode == "mixed" or
+          precisionMode == "adaptive") and
+        "precisionMode must be either 'full', 'mixed' or 'adaptive'");
+    precisionMode_ = precisionMode;
+
+    // bounds at current zeros tell stalled zeros apart
+    const bool bounds = stopCriterion_ == "bound" or precisionMode == "adaptive";
+    if (bounds == bound_.empty()) {
+      bound_.resize(bounds ? this->deg_ : 0);
+      for(unsigned int i = 0; i < this->deg_; i++) compLogDeriv(i);
+    }
+  }
+
+  //----------------------------------------------------------------------------//
+  //! select whether or not to exploit real coeffs
+  //! zeros of real coeffs are symmetric about the real axis, so once they
+  //! have sorted themselves into conjugate pairs, see pairZeros, only one
+  //! zero of each pair is iterated, and imag parts of coeffs are skipped in
+  //! evaluations
+  //! @param  realCoeffs  true only if every coeff is real
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::setRealCoeffs(const bool realCoeffs)
+  {
+    assert((!realCoeffs or std::all_of(this->coeffs_.cbegin(), this->coeffs_.cend(),
+            [](const std::complex<T> c) {return !c.imag();})) and
+        "coeffs must be real if realCoeffs");
+    realCoeffs_ = realCoeffs;
+    initData();
+  }
+
+  //----------------------------------------------------------------------------//
+  //! select whether or not to detect clusters of zeros
+  //! after a sweep in which no more zeros converged, zeros whose inclusion
+  //! discs overlap, away from the others, are taken for a zero of
+  //! multiplicity the number of them and iterated together at quadratic
+  //! rather than linear rate, see updateClusters
+  //! ignored with real coeffs
+  //! @param  clusterDetection  if true, clusters are detected
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::setClusterDetection(const bool clusterDetection)
+  {
+    clusterDetection_ = clusterDetection;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! return estimated multiplicity of the zero each zero approximates
+  //! the m zeros of a cluster that converged have multiplicity m, and the
+  //! others 1
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  const std::vector<unsigned int>& ZeroFinder<T>::getMultiplicities() const {return mult_;}
+
+  //----------------------------------------------------------------------------//
+  //! select test for convergence
+  //! "tol" stops a zero once |p| < tol, while "bound" also stops it once |p|
+  //! is within a running bound on the rounding error of its evaluation,
+  //! beyond which iterating doesn't help
+  //! @param  stopCriterion  either "tol" or "bound"
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::setStopCriterion(const std::string stopCriterion)
+  {
+    assert((stopCriterion == "tol" or stopCriterion == "bound") and
+        "stopCriterion must be either 'tol' or 'bound'");
+    stopCriterion_ = stopCriterion;
+
+    // bounds at current zeros
+    const bool bounds = stopCriterion == "bound" or precisionMode_ == "adaptive";
+    if (bounds == bound_.empty()) {
+      bound_.resize(bounds ? this->deg_ : 0);
+      for(unsigned int i = 0; i < this->deg_; i++) compLogDeriv(i);
+    }
+  }
+
+  //----------------------------------------------------------------------------//
+  //! start the stream of random numbers over from seed
+  //! "rand" and "symm" guesses are drawn anew, the same on any thread for the
+  //! same seed, while "newton" guesses don't depend on it
+  //! @param  seed  seed of stream (SplitMix::DEFAULT_SEED to start with)
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::setSeed(const uint64_t seed)
+  {
+    rng_.seed(seed);
+    if (initMode_ != "newton") initData();
+  }
+
+  //----------------------------------------------------------------------------//
+  //! return radii of discs about the zeros whose union holds all zeros
+  //! each connected component of m discs holds exactly m zeros, see
+  //! Neumaier, J. Comput. Appl. Math. 156 (2003) 389-401
+  //! r_i = n |p(z_i)| / |a_n prod_{j != i} (z_i - z_j)|, which is formed from
+  //! logs, with |p(z_i)| raised by the bound on its rounding error
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  std::vector<T> ZeroFinder<T>::getRadii() const
+  {
+    std::vector<T> radii(this->deg_);
+    const T logLead = log(abs(this->coeffs_.back())),
+            logDeg = log(static_cast<T>(this->deg_)),
+            log2 = log(static_cast<T>(2));
+    for(unsigned int i = 0; i < this->deg_; i++) {
+
+      // log of |p| plus its error bound, using the reverse polynomial if needed
+      std::complex<T> val,
+                      deriv;
+      T bound,
+        logP;
+      const T mag = abs(zeros_[i]);
+      if (mag < 1) {
+        const int exp = this->evalDerivScaled(zeros_[i], val, deriv, &bound);
+        logP = log(abs(val) + bound) + exp * log2;
+      }
+      else {
+        const int exp = rev_->evalDerivScaled(static_cast<std::complex<T>>(1) / zeros_[i],
+            val, deriv, &bound);
+        logP = log(abs(val) + bound) + exp * log2 + this->deg_ * log(mag);
+      }
+
+      T logRad = logDeg - logLead + logP;
+      for(unsigned int j = 0; j < this->deg_; j++) {
+        if (j != i) logRad -= log(abs(zeros_[i] - zeros_[j]));
+      }
+      radii[i] = exp(logRad);
+    }
+
+    return radii;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! return number of iterations performed
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  unsigned int ZeroFinder<T>::getIters() const {return iters_;}
+
+  //----------------------------------------------------------------------------//
+  //! return statistics of the last call to compZeros
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  const SolveStats<T>& ZeroFinder<T>::getStats() const {return stats_;}
+
+  //----------------------------------------------------------------------------//
+  //! select whether or not to collect times, evaluations and active rows
+  //! they cost a clock reading per phase and a pass over the updated zeros
+  //! per iteration, so only iterations, the largest residual and the status
+  //! are kept by default
+  //! @param  stats  if true, all of SolveStats is filled
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::setStats(const bool stats)
+  {
+    collectStats_ = stats;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! call callback after each iteration with the statistics so far
+  //! residuals are only reduced to stats.maxResid when a callback is set,
+  //! so there is no overhead without one
+  //! @param  callback  function of the statistics (none if null)
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::setIterCallback(std::function<void(const SolveStats<T> &)> callback)
+  {
+    iterCallback_ = callback;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! stop iterating once deadline has passed
+  //! it is checked before each sweep, so compZeros returns at most a sweep
+  //! later, with the zeros so far, and a later compZeros resumes from them
+  //! @param  deadline  time to stop at (never if time_point::max())
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::setDeadline(const std::chrono::steady_clock::time_point deadline)
+  {
+    deadline_ = deadline;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! stop iterating once token, or any copy of it, is cancelled
+  //! as with a deadline, compZeros returns at most a sweep later
+  //! @param  token  token to check before each sweep
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void ZeroFinder<T>::setCancelToken(const CancelToken &token)
+  {
+    cancelToken_ = token;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! return whether or not each zero converged to within tol
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  const std::vector<unsigned char>& ZeroFinder<T>::getConv() const {return conv_;}
+
+  //----------------------------------------------------------------------------//
+  //! return residual |p| at each zero
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  const std::vector<T>& ZeroFinder<T>::getResids() const {return resid_;}
+
+  //----------------------------------------------------------------------------//
+  //! return zeros, with their convergence and residuals, and why the last
+  //! compZeros stopped
+  //! zeros that converged before a solve was stopped early keep their flags,
+  //! so they may be used while the rest are not
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  SolveResult<T> ZeroFinder<T>::getResult() const
+  {
+    SolveResult<T> result;
+    result.zeros = zeros_;
+    result.conv = conv_;
+    result.resids = resid_;
+    result.iters = iters_;
+    result.status = stats_.status;
+    return result;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! run compZeros on another thread until converged, maxIters, deadline,
+  //! or token is cancelled, which hold for this solve only, the finder's own
+  //! (see setDeadline, setCancelToken) coming back before the future is ready
+  //! the finder must outlive the future and be left alone until it is ready
+  //! @param  deadline  time to stop at (never if time_point::max())
+  //! @param  token     token to check before each sweep
+  //! returns future of the result, see getResult
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  std::future<SolveResult<T>> ZeroFinder<T>::compZerosAsync(
+      const std::chrono::steady_clock::time_point deadline,
+      const CancelToken &token)
+  {
+    const std::chrono::steady_clock::time_point ownDeadline = deadline_;
+    const CancelToken ownToken = cancelToken_;
+    deadline_ = deadline;
+    cancelToken_ = token;
+    return std::async(std::launch::async, [this, ownDeadline, ownToken]() {
+      compZeros();
+      deadline_ = ownDeadline;
+      cancelToken_ = ownToken;
+      return getResult();
+    });
+  }
 
   //----------------------------------------------------------------------------//
   // specialization
   //----------------------------------------------------------------------------//
   template class Polynomial<float>;
   template class Polynomial<double>;
+  template class Polynomial<long double>;
+  template class Polynomial<DoubleDouble>;
+  template class Polynomial<QuadDouble>;
 
   template class ZeroFinder<float>;
   template class ZeroFinder<double>;
+  template class ZeroFinder<long double>;
+  template class ZeroFinder<DoubleDouble>;
+  template class ZeroFinder<QuadDouble>;
 
 }
@@ -0,0 +1,594 @@
+// includes, system
+#include <vector>
+#include <string>
+#include <cassert>
+#include <complex>
+#include <cfloat>
+#include <algorithm>
+#include <numeric>
+#include <memory>
+#include <thread>
+#include <cmath>
+
+// includes, project
+#include "aberth.h"
+
+namespace aberth
+{
+
+  //----------------------------------------------------------------------------//
+  //! non-default constructor
+  //! @param  coeffs  coefficients of each polynomial, all of the same degree
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  BatchZeroFinder<T>::BatchZeroFinder(
+      const std::vector<std::vector<std::complex<T>>> &coeffs,
+      const T tol,
+      const unsigned int maxIters,
+      const std::string initMode) :
+    batch_(coeffs.size()),
+    tiles_((coeffs.size() + BATCH_TILE - 1) / BATCH_TILE),
+    deg_(coeffs.size() ? coeffs[0].size() - 1 : 0),
+    tol_(tol),
+    maxIters_(maxIters),
+    initMode_(initMode)
+  {
+
+    // batch must be nonempty
+    assert(batch_ and "Batch must contain at least one polynomial");
+
+    // degree must be at least 1
+    assert(1 <= deg_ and "Degree of polynomial must be at least 1");
+
+    // every polynomial must have the same degree
+    for (const auto &coeffsI : coeffs) {
+      assert(coeffsI.size() == deg_ + 1 and
+          "Polynomials in batch must have the same degree");
+    }
+
+    // tolerance must be above smallest positive double
+    assert(DBL_MIN <= tol and "tol must be at least DBL_MIN");
+
+    // only two methods of initializing zeros
+    assert((initMode == "rand" or initMode == "symm") and
+        "initMode must be either 'rand' or 'symm'");
+
+    // allocate everything once for the whole (padded) batch
+    const unsigned int lanes = tiles_ * BATCH_TILE;
+    coeffsRe_.resize(lanes * (deg_ + 1));
+    coeffsIm_.resize(lanes * (deg_ + 1));
+    zerosRe_.resize(lanes * deg_);
+    zerosIm_.resize(lanes * deg_);
+    invDiffSumRe_.assign(lanes * deg_, 0);
+    invDiffSumIm_.assign(lanes * deg_, 0);
+    conv_.assign(lanes * deg_, false);
+    polyConv_.assign(lanes, false);
+    iters_.assign(lanes, 0);
+
+    // padding lanes repeat the last polynomial and are never reported
+    for (unsigned int b = 0; b < lanes; b++) {
+      const std::vector<std::complex<T>> &src = coeffs[std::min(b, batch_ - 1)];
+      for (unsigned int k = 0; k <= deg_; k++) {
+        coeffsRe_[index(b, k, deg_ + 1)] = src[k].real();
+        coeffsIm_[index(b, k, deg_ + 1)] = src[k].imag();
+      }
+    }
+
+    // compute initial guesses for zeros
+    initZeros();
+  }
+
+  //----------------------------------------------------------------------------//
+  //! offset of kth entry of the bth polynomial in an array of length len
+  //! entries of the polynomials in a tile are contiguous for each k
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  unsigned int BatchZeroFinder<T>::index(const unsigned int b,
+      const unsigned int k,
+      const unsigned int len) const
+  {
+    return (b / BATCH_TILE) * BATCH_TILE * len + k * BATCH_TILE + b % BATCH_TILE;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! compute initial guesses for zeros
+  //! same scheme as ZeroFinder<T>::initZeros, one polynomial after the other
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void BatchZeroFinder<T>::initZeros()
+  {
+
+    // real and imag component of guesses and upper bound on all zeros' magnitude
+    T a,
+      b,
+      rMax,
+      lead,
+      curr;
+
+    // initial zero for symm
+    std::complex<T> z;
+
+    // two uniform draws for each random guess of every polynomial, drawn at
+    // once from this finder's own stream
+    const unsigned int guesses = initMode_ == "symm" ? 1 : deg_;
+    std::vector<T> draws(2 * guesses * batch_);
+    rng_.fill(draws.data(), draws.size());
+
+    for (unsigned int p = 0; p < tiles_ * BATCH_TILE; p++) {
+
+      // padding lanes copy the guesses of the last polynomial
+      if (batch_ <= p) {
+        for (unsigned int i = 0; i < deg_; i++) {
+          zerosRe_[index(p, i, deg_)] = zerosRe_[index(batch_ - 1, i, deg_)];
+          zerosIm_[index(p, i, deg_)] = zerosIm_[index(batch_ - 1, i, deg_)];
+        }
+        continue;
+      }
+
+      // cauchy bound on roots' magnitude
+      lead = abs(std::complex<T>(coeffsRe_[index(p, deg_, deg_ + 1)],
+            coeffsIm_[index(p, deg_, deg_ + 1)]));
+      rMax = 0;
+      for (unsigned int k = 0; k <= deg_; k++) {
+        curr = abs(std::complex<T>(coeffsRe_[index(p, k, deg_ + 1)],
+              coeffsIm_[index(p, k, deg_ + 1)])) / lead;
+        if (rMax < curr) rMax = curr;
+      }
+      rMax += static_cast<T>(1);
+
+      // compute a guess for each root
+      for (unsigned int i = 0; i < deg_; i++) {
+        if (initMode_ == "rand" or (initMode_ == "symm" and !i)) {
+          a = rMax * draws[2 * (p * guesses + i)];
+          b = sqrt(rMax*rMax - a*a) * draws[2 * (p * guesses + i) + 1];
+          z = {a, b};
+        }
+        if (initMode_ == "symm" and i) z = (z * z) / abs(z);
+        zerosRe_[index(p, i, deg_)] = z.real();
+        zerosIm_[index(p, i, deg_)] = z.imag();
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------//
+  //! use Aberth's method to approximate zeros of every polynomial
+  //! tiles are iterated one at a time so that their data stay in cache
+  //! @param  verbose  whether or not extra info will be printed
+  //! returns true iff all zeros of all polynomials converged to within tol_
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  bool BatchZeroFinder<T>::compZeros(const bool verbose)
+  {
+
+    // number of converged polynomials and most iterations used by any of them
+    unsigned int nConv = 0,
+                 mostIters = 0;
+
+    for (unsigned int t = 0; t < tiles_; t++) {
+
+      // whether or not every polynomial in this tile converged
+      bool tileConv = false;
+      for (unsigned int it = 0; it < maxIters_ and !tileConv; it++) {
+
+        // compute diffSum then update zeros
+        compInvDiffSum(t);
+        newtonStep(t);
+
+        // determine which polynomials have converged
+        tileConv = true;
+        for (unsigned int l = 0; l < BATCH_TILE; l++) {
+          const unsigned int b = t * BATCH_TILE + l;
+          if (polyConv_[b]) continue;
+          iters_[b]++;
+          polyConv_[b] = true;
+          for (unsigned int i = 0; i < deg_; i++) {
+            if (!conv_[index(b, i, deg_)]) {polyConv_[b] = false; break;}
+          }
+          if (!polyConv_[b]) tileConv = false;
+        }
+      }
+    }
+
+    for (unsigned int b = 0; b < batch_; b++) {
+      if (polyConv_[b]) nConv++;
+      if (mostIters < iters_[b]) mostIters = iters_[b];
+    }
+
+    // if requested, print verbose output
+    if (verbose) {
+
+      // print error message if not all polynomials have converged
+      if (nConv != batch_)
+        printf("Failed to converge %u of %u polynomials after maximum (%u) "
+               "iterations\n", batch_ - nConv, batch_, maxIters_);
+
+      printf("Polynomials in batch = %u\n", batch_);
+      printf("Converged            = %u\n", nConv);
+      printf("Max iterations       = %u\n", mostIters);
+    }
+
+    return nConv == batch_;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! compute invDiffSum elts for one tile
+  //! 1 / d is formed as conj(d) / |d|^2 so the loop over the tile's lanes
+  //! is free of complex division
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void BatchZeroFinder<T>::compInvDiffSum(const unsigned int tile)
+  {
+
+    // zeros and sums of this tile
+    const T *zRe = &zerosRe_[tile * BATCH_TILE * deg_],
+            *zIm = &zerosIm_[tile * BATCH_TILE * deg_];
+    T *sRe = &invDiffSumRe_[tile * BATCH_TILE * deg_],
+      *sIm = &invDiffSumIm_[tile * BATCH_TILE * deg_];
+
+    for (unsigned int i = 0; i < deg_; i++) {
+      T accRe[BATCH_TILE] = {},
+        accIm[BATCH_TILE] = {};
+      for (unsigned int j = 0; j < deg_; j++) {
+        if (i == j) continue;
+        for (unsigned int l = 0; l < BATCH_TILE; l++) {
+          const T dRe = zRe[i * BATCH_TILE + l] - zRe[j * BATCH_TILE + l],
+                  dIm = zIm[i * BATCH_TILE + l] - zIm[j * BATCH_TILE + l],
+                  inv = static_cast<T>(1) / (dRe * dRe + dIm * dIm);
+          accRe[l] += dRe * inv;
+          accIm[l] -= dIm * inv;
+        }
+      }
+      for (unsigned int l = 0; l < BATCH_TILE; l++) {
+        sRe[i * BATCH_TILE + l] = accRe[l];
+        sIm[i * BATCH_TILE + l] = accIm[l];
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------//
+  //! update zeros of one tile with a Newton step
+  //! as in ZeroFinder<T>::newtonStep, zeros of magnitude at least 1 use the
+  //! reverse polynomial (Bini, Numerical Algorithms 13 (1996) 179-200)
+  //! p and p' are evaluated in a single Horner pass
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void BatchZeroFinder<T>::newtonStep(const unsigned int tile)
+  {
+
+    // coeffs, zeros, sums and flags of this tile
+    const T *aRe = &coeffsRe_[tile * BATCH_TILE * (deg_ + 1)],
+            *aIm = &coeffsIm_[tile * BATCH_TILE * (deg_ + 1)],
+            *sRe = &invDiffSumRe_[tile * BATCH_TILE * deg_],
+            *sIm = &invDiffSumIm_[tile * BATCH_TILE * deg_];
+    T *zRe = &zerosRe_[tile * BATCH_TILE * deg_],
+      *zIm = &zerosIm_[tile * BATCH_TILE * deg_];
+    unsigned char *conv = &conv_[tile * BATCH_TILE * deg_];
+    const unsigned char *polyConv = &polyConv_[tile * BATCH_TILE];
+
+    const T n = static_cast<T>(deg_);
+
+    for (unsigned int i = 0; i < deg_; i++) {
+
+      // point of evaluation (z or 1/z), value and derivative there
+      T yRe[BATCH_TILE], yIm[BATCH_TILE],
+        pRe[BATCH_TILE], pIm[BATCH_TILE],
+        dRe[BATCH_TILE], dIm[BATCH_TILE];
+      bool rev[BATCH_TILE];
+
+      for (unsigned int l = 0; l < BATCH_TILE; l++) {
+        const T xRe = zRe[i * BATCH_TILE + l],
+                xIm = zIm[i * BATCH_TILE + l],
+                mag = xRe * xRe + xIm * xIm;
+        rev[l] = !(mag < 1);
+        yRe[l] = rev[l] ? xRe / mag : xRe;
+        yIm[l] = rev[l] ? -xIm / mag : xIm;
+        pRe[l] = rev[l] ? aRe[l] : aRe[deg_ * BATCH_TILE + l];
+        pIm[l] = rev[l] ? aIm[l] : aIm[deg_ * BATCH_TILE + l];
+        dRe[l] = 0;
+        dIm[l] = 0;
+      }
+
+      // fused Horner for p and p' (or the reverse polynomial and its derivative)
+      for (unsigned int k = 1; k <= deg_; k++) {
+        for (unsigned int l = 0; l < BATCH_TILE; l++) {
+          const unsigned int kk = rev[l] ? k : deg_ - k;
+          const T cRe = aRe[kk * BATCH_TILE + l],
+                  cIm = aIm[kk * BATCH_TILE + l],
+                  tRe = dRe[l] * yRe[l] - dIm[l] * yIm[l] + pRe[l],
+                  tIm = dRe[l] * yIm[l] + dIm[l] * yRe[l] + pIm[l],
+                  uRe = pRe[l] * yRe[l] - pIm[l] * yIm[l] + cRe,
+                  uIm = pRe[l] * yIm[l] + pIm[l] * yRe[l] + cIm;
+          dRe[l] = tRe; dIm[l] = tIm;
+          pRe[l] = uRe; pIm[l] = uIm;
+        }
+      }
+
+      for (unsigned int l = 0; l < BATCH_TILE; l++) {
+
+        // converged polynomials are left alone
+        if (polyConv[l]) continue;
+
+        const std::complex<T> one = 1,
+                              y = {yRe[l], yIm[l]},
+                              p = {pRe[l], pIm[l]},
+                              d = {dRe[l], dIm[l]},
+                              s = {sRe[i * BATCH_TILE + l], sIm[i * BATCH_TILE + l]};
+
+        // ratio of polynomial evaluated at z to its derivative evaluated at z
+        const std::complex<T> ratio = rev[l] ?
+          one / (n * y - (y * y * d / p)) : p / d;
+
+        // compute and apply new correction
+        const std::complex<T> corr = ratio / (one - ratio * s);
+        zRe[i * BATCH_TILE + l] -= corr.real();
+        zIm[i * BATCH_TILE + l] -= corr.imag();
+      }
+    }
+
+    // determine which zeros have converged after applying corrections
+    for (unsigned int i = 0; i < deg_; i++) {
+      T pRe[BATCH_TILE], pIm[BATCH_TILE];
+      for (unsigned int l = 0; l < BATCH_TILE; l++) {
+        pRe[l] = aRe[deg_ * BATCH_TILE + l];
+        pIm[l] = aIm[deg_ * BATCH_TILE + l];
+      }
+      for (unsigned int k = deg_; k-- > 0;) {
+        for (unsigned int l = 0; l < BATCH_TILE; l++) {
+          const T xRe = zRe[i * BATCH_TILE + l],
+                  xIm = zIm[i * BATCH_TILE + l],
+                  uRe = pRe[l] * xRe - pIm[l] * xIm + aRe[k * BATCH_TILE + l],
+                  uIm = pRe[l] * xIm + pIm[l] * xRe + aIm[k * BATCH_TILE + l];
+          pRe[l] = uRe; pIm[l] = uIm;
+        }
+      }
+      for (unsigned int l = 0; l < BATCH_TILE; l++) {
+        if (!conv[i * BATCH_TILE + l] and
+            abs(std::complex<T>(pRe[l], pIm[l])) < tol_)
+          conv[i * BATCH_TILE + l] = true;
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------//
+  //! return zeros of the bth polynomial sorted by their magnitude
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  std::vector<std::complex<T>> BatchZeroFinder<T>::getZeros(
+      const unsigned int b) const
+  {
+    assert(b < batch_ and "Index must be within batch");
+
+    std::vector<std::complex<T>> zeros(deg_);
+    for (unsigned int i = 0; i < deg_; i++) {
+      zeros[i] = {zerosRe_[index(b, i, deg_)], zerosIm_[index(b, i, deg_)]};
+    }
+    sort(zeros.begin(), zeros.end(), [](const auto v, const auto w)
+        {return abs(v) < abs(w);});
+    return zeros;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! whether or not all zeros of the bth polynomial converged
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  bool BatchZeroFinder<T>::getConv(const unsigned int b) const
+  {
+    assert(b < batch_ and "Index must be within batch");
+    return polyConv_[b];
+  }
+
+  //----------------------------------------------------------------------------//
+  //! number of iterations performed for the bth polynomial
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  unsigned int BatchZeroFinder<T>::getIters(const unsigned int b) const
+  {
+    assert(b < batch_ and "Index must be within batch");
+    return iters_[b];
+  }
+
+  //----------------------------------------------------------------------------//
+  //! number of polynomials in batch
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  unsigned int BatchZeroFinder<T>::size() const {return batch_;}
+
+  //----------------------------------------------------------------------------//
+  //! start the stream of random numbers over from seed, drawing guesses anew
+  //! and discarding any iterations
+  //! @param  seed  seed of stream (SplitMix::DEFAULT_SEED to start with)
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void BatchZeroFinder<T>::setSeed(const uint64_t seed)
+  {
+    rng_.seed(seed);
+    std::fill(conv_.begin(), conv_.end(), false);
+    std::fill(polyConv_.begin(), polyConv_.end(), false);
+    std::fill(iters_.begin(), iters_.end(), 0);
+    initZeros();
+  }
+
+  //----------------------------------------------------------------------------//
+  // specialization
+  //----------------------------------------------------------------------------//
+  template class BatchZeroFinder<float>;
+  template class BatchZeroFinder<double>;
+
+
+  //----------------------------------------------------------------------------//
+  //! non-default constructor
+  //! @param  coeffs  coefficients of each polynomial, of any degrees
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  MixedBatchZeroFinder<T>::MixedBatchZeroFinder(
+      const std::vector<std::vector<std::complex<T>>> &coeffs,
+      const T tol,
+      const unsigned int maxIters,
+      const std::string initMode) :
+    coeffs_(coeffs),
+    tol_(tol),
+    maxIters_(maxIters),
+    initMode_(initMode),
+    splitDeg_(500),
+    zeros_(coeffs.size()),
+    conv_(coeffs.size(), false),
+    iters_(coeffs.size(), 0)
+  {
+
+    // batch must be nonempty
+    assert(coeffs_.size() and "Batch must contain at least one polynomial");
+
+    // degree must be at least 1
+    for (const auto &coeffsI : coeffs_) {
+      assert(2 <= coeffsI.size() and "Degree of polynomial must be at least 1");
+    }
+
+    // tolerance must be above smallest positive double
+    assert(DBL_MIN <= tol and "tol must be at least DBL_MIN");
+
+    // only three methods of initializing zeros
+    assert((initMode == "rand" or initMode == "symm" or initMode == "newton") and
+        "initMode must be either 'rand', 'symm' or 'newton'");
+
+    setNumThreads(std::thread::hardware_concurrency());
+  }
+
+  //----------------------------------------------------------------------------//
+  //! solve with a new pool of nThreads threads (one if 0)
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void MixedBatchZeroFinder<T>::setNumThreads(const unsigned int nThreads)
+  {
+    setThreadPool(std::make_shared<WorkStealingPool>(std::max(1u, nThreads)));
+  }
+
+  //----------------------------------------------------------------------------//
+  //! solve with an existing pool, which may be shared with other finders
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void MixedBatchZeroFinder<T>::setThreadPool(std::shared_ptr<WorkStealingPool> pool)
+  {
+    assert(pool and "Pool must not be null");
+    pool_ = pool;
+    finders_.clear();
+    finders_.resize(pool_->size());
+  }
+
+  //----------------------------------------------------------------------------//
+  //! split sweeps of polynomials of degree at least splitDeg over threads
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void MixedBatchZeroFinder<T>::setSplitDegree(const unsigned int splitDeg)
+  {
+    splitDeg_ = splitDeg;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! seed the streams that "rand" and "symm" guesses of each polynomial are
+  //! drawn from
+  //! @param  seed  seed of stream (SplitMix::DEFAULT_SEED to start with)
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void MixedBatchZeroFinder<T>::setSeed(const uint64_t seed)
+  {
+    rng_.seed(seed);
+  }
+
+  //----------------------------------------------------------------------------//
+  //! estimated cost of solving the bth polynomial: deg^2 per sweep, times a
+  //! number of sweeps growing with log(deg), faster from newton guesses
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  double MixedBatchZeroFinder<T>::compCost(const unsigned int b) const
+  {
+    const double deg = coeffs_[b].size() - 1,
+                 iters = initMode_ == "newton" ? 2 + 1.5 * std::log2(deg + 1)
+                                               : 5 * std::log2(deg + 1);
+    return deg * deg * std::min<double>(iters, maxIters_);
+  }
+
+  //----------------------------------------------------------------------------//
+  //! use Aberth's method to approximate zeros of every polynomial
+  //! each polynomial is solved as by a ZeroFinder<T> with the same settings,
+  //! seeded with the bth draw of this finder's stream, so its zeros don't
+  //! depend on the number of threads
+  //! returns true if all zeros of every polynomial converged
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  bool MixedBatchZeroFinder<T>::compZeros()
+  {
+
+    // costliest polynomials first
+    std::vector<double> costs(size());
+    for (unsigned int b = 0; b < size(); b++) costs[b] = compCost(b);
+    std::vector<unsigned int> order(size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+        [&costs](const unsigned int i, const unsigned int j) {return costs[i] > costs[j];});
+
+    pool_->runTasks(order, [this](const unsigned int b, const unsigned int thread) {
+      std::unique_ptr<ZeroFinder<T>> &finder = finders_[thread];
+      const std::vector<std::complex<T>> &coeffs = coeffs_[b];
+
+      // random guesses come from a stream of the polynomial's own, whichever
+      // thread draws them
+      if (finder) finder->reset(coeffs.data(), coeffs.size(), rng_.at(b));
+      else {
+        finder = std::make_unique<ZeroFinder<T>>(coeffs, tol_, maxIters_, initMode_);
+        finder->setSeed(rng_.at(b));
+      }
+
+      // large polynomials spread their sweeps over free threads
+      finder->setThreadPool(splitDeg_ <= coeffs.size() - 1 ? pool_ : nullptr);
+      conv_[b] = finder->compZeros();
+      zeros_[b] = finder->getZeros();
+      iters_[b] = finder->getIters();
+    });
+
+    return std::all_of(conv_.begin(), conv_.end(), [](const unsigned char c) {return c;});
+  }
+
+  //----------------------------------------------------------------------------//
+  //! return (not necessarily converged) zeros of the bth polynomial
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  const std::vector<std::complex<T>>& MixedBatchZeroFinder<T>::getZeros(
+      const unsigned int b) const
+  {
+    assert(b < size() and "Index must be within batch");
+    return zeros_[b];
+  }
+
+  //----------------------------------------------------------------------------//
+  //! whether or not all zeros of the bth polynomial converged
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  bool MixedBatchZeroFinder<T>::getConv(const unsigned int b) const
+  {
+    assert(b < size() and "Index must be within batch");
+    return conv_[b];
+  }
+
+  //----------------------------------------------------------------------------//
+  //! number of iterations performed for the bth polynomial
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  unsigned int MixedBatchZeroFinder<T>::getIters(const unsigned int b) const
+  {
+    assert(b < size() and "Index must be within batch");
+    return iters_[b];
+  }
+
+  //----------------------------------------------------------------------------//
+  //! number of polynomials in batch
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  unsigned int MixedBatchZeroFinder<T>::size() const {return coeffs_.size();}
+
+  //----------------------------------------------------------------------------//
+  // specialization
+  //----------------------------------------------------------------------------//
+  template class MixedBatchZeroFinder<float>;
+  template class MixedBatchZeroFinder<double>;
+
+}
@@ -0,0 +1,689 @@
+/* Double-double and quad-double arithmetic from error-free transformations */
+#ifndef _ABERTH_DD_H_
+#define _ABERTH_DD_H_
+
+// includes, system
+#include <cmath>
+#include <cfloat>
+#include <limits>
+#include <algorithm>
+#include <complex>
+
+namespace aberth
+{
+  namespace dd
+  {
+
+    //----------------------------------------------------------------------------//
+    //! error-free transformations of doubles, which rely on every operation
+    //! being rounded to nearest as written (no -ffast-math, no contraction)
+    //----------------------------------------------------------------------------//
+
+    //! s = fl(a + b) and e = a + b - s exactly
+    inline double twoSum(const double a, const double b, double &e)
+    {
+      const double s = a + b,
+                   bb = s - a;
+      e = (a - (s - bb)) + (b - bb);
+      return s;
+    }
+
+    //! as twoSum, for |a| >= |b| (or a = 0)
+    inline double fastTwoSum(const double a, const double b, double &e)
+    {
+      const double s = a + b;
+      e = b - (s - a);
+      return s;
+    }
+
+    //! a + b + c = a + b + c with a = fl(a + b + c) after, and b, c the
+    //! errors, of which c is that of b
+    inline void threeSum(double &a, double &b, double &c)
+    {
+      double t2, t3;
+      const double t1 = twoSum(a, b, t2);
+      a = twoSum(c, t1, t3);
+      b = twoSum(t2, t3, c);
+    }
+
+    //! as threeSum, with b the rounded sum of the errors
+    inline void threeSum2(double &a, double &b, const double c)
+    {
+      double t2, t3;
+      const double t1 = twoSum(a, b, t2);
+      a = twoSum(c, t1, t3);
+      b = t2 + t3;
+    }
+
+    //! p = fl(a b) and e = a b - p exactly, using fma
+    inline double twoProd(const double a, const double b, double &e)
+    {
+      const double p = a * b;
+      e = std::fma(a, b, -p);
+      return p;
+    }
+
+    //----------------------------------------------------------------------------//
+    //! Unevaluated sum of N doubles, decreasing in magnitude and not
+    //! overlapping, for about 52 N bits of precision with the exponent range
+    //! of double
+    //! N = 2 (DoubleDouble) uses the double-word algorithms of Joldes, Muller
+    //! and Popescu, ACM TOMS 44 (2017) 15, with fma, N = 4 (QuadDouble) those
+    //! of the QD library of Hida, Li and Bailey, ARITH 15 (2001) 155-162, and
+    //! N = 3 sums all partial terms exactly before rounding to N components,
+    //! after Joldes, Marty, Muller and Popescu, IEEE TC 65 (2016) 1197-1210
+    //! elementary functions are accurate to the full precision, though sin
+    //! and cos only for arguments of moderate size
+    //----------------------------------------------------------------------------//
+    template <unsigned int N>
+    class Expansion
+    {
+      static_assert(2 <= N and N <= 4, "Expansions have 2 to 4 components");
+
+      //**************************************//
+      // data members
+      //**************************************//
+
+      protected:
+
+        //! components, from leading to trailing
+        double x_[N];
+
+      //**************************************//
+      // member functions
+      //**************************************//
+
+      public:
+
+        //! zero
+        Expansion() : x_{} {}
+
+        //! exact value of a double
+        Expansion(const double x) : x_{x} {}
+
+        //! leading components of an expansion of another length
+        template <unsigned int M>
+        explicit Expansion(const Expansion<M> &other) : x_{}
+        {
+          for(unsigned int k = 0; k < std::min(N, M); k++) x_[k] = other[k];
+        }
+
+        //! kth component
+        double operator[](const unsigned int k) const {return x_[k];}
+
+        //! rounded to double, which is the leading component
+        explicit operator double() const {return x_[0];}
+
+        //! rounded to float
+        explicit operator float() const {return static_cast<float>(x_[0]);}
+
+        //! nonzero, which the leading component is iff the expansion is
+        explicit operator bool() const {return x_[0] != 0;}
+
+        //! sum of m doubles in any order, rounded to N components
+        //! they are sorted by decreasing magnitude, which products of
+        //! expansions whose components leave gaps need, then a pass from the
+        //! trailing end gathers exact partial sums, and a pass from the
+        //! leading end keeps the nonzero parts (Priest's VecSum, then
+        //! VecSumErrBranch), so only the last component rounds
+        static Expansion renormalize(double *c, const unsigned int m)
+        {
+          Expansion z;
+
+          // insertion sort, as terms are generated nearly in order
+          for(unsigned int i = 1; i < m; i++) {
+            const double t = c[i];
+            unsigned int j = i;
+            for(; j and std::abs(c[j - 1]) < std::abs(t); j--) c[j] = c[j - 1];
+            c[j] = t;
+          }
+          double s = c[m - 1];
+          for(unsigned int i = m - 1; i-- > 0;) s = twoSum(c[i], s, c[i + 1]);
+          if (!std::isfinite(s)) {z.x_[0] = s; return z;}
+          unsigned int k = 0;
+          for(unsigned int i = 1; i < m; i++) {
+            double e;
+            const double r = twoSum(s, c[i], e);
+            if (e != 0) {
+              z.x_[k] = r;
+              if (++k == N) return z;
+              s = e;
+            }
+            else s = r;
+          }
+          z.x_[k] = s;
+          return z;
+        }
+
+        //! sum of m doubles about ordered by decreasing magnitude, so that the
+        //! passes of renormalize need no sort and only fastTwoSum, and the last
+        //! component takes the rest (the fixed-size renormalization of QD)
+        static Expansion renormalizeOrdered(double *c, const unsigned int m)
+        {
+          Expansion z;
+          double s = c[m - 1];
+          for(unsigned int i = m - 1; i-- > 0;) s = fastTwoSum(c[i], s, c[i + 1]);
+          if (!std::isfinite(s)) {z.x_[0] = s; return z;}
+          unsigned int k = 0;
+          for(unsigned int i = 1; i < m; i++) {
+            double e;
+            const double r = k + 1 < N ? fastTwoSum(s, c[i], e) : (e = 0, s + c[i]);
+            if (e != 0) {
+              z.x_[k++] = r;
+              s = e;
+            }
+            else s = r;
+          }
+          z.x_[k] = s;
+          return z;
+        }
+
+        //! from components that need not be normalized
+        static Expansion fromComponents(const double *c, const unsigned int m)
+        {
+          double t[2 * N + 1];
+          std::copy(c, c + m, t);
+          return renormalize(t, m);
+        }
+
+        //! negation
+        Expansion operator-() const
+        {
+          Expansion z;
+          for(unsigned int k = 0; k < N; k++) z.x_[k] = -x_[k];
+          return z;
+        }
+
+        //! sum
+        //! as error terms of infinities are nan, the arithmetic operators
+        //! return the rounded double result once it isn't finite
+        friend Expansion operator+(const Expansion &a, const Expansion &b)
+        {
+          if (!std::isfinite(a.x_[0] + b.x_[0])) return a.x_[0] + b.x_[0];
+          if constexpr (N == 2) {
+            double sl, tl, vl, zl;
+            const double sh = twoSum(a.x_[0], b.x_[0], sl),
+                         th = twoSum(a.x_[1], b.x_[1], tl),
+                         vh = fastTwoSum(sh, sl + th, vl),
+                         zh = fastTwoSum(vh, tl + vl, zl);
+            const double z[2] = {zh, zl};
+            return fromNormalized(z);
+          }
+          else {
+
+            // merge components by decreasing magnitude
+            double t[2 * N];
+            unsigned int i = 0, j = 0;
+            while (i < N or j < N) {
+              if (j == N or (i < N and std::abs(b.x_[j]) <= std::abs(a.x_[i]))) {
+                t[i + j] = a.x_[i];
+                i++;
+              }
+              else {
+                t[i + j] = b.x_[j];
+                j++;
+              }
+            }
+            if constexpr (N == 4) return renormalizeOrdered(t, 2 * N);
+            else return renormalize(t, 2 * N);
+          }
+        }
+
+        //! sum accurate only relative to |a| + |b|, not |a + b|, for the
+        //! remainders of long division, whose leading components cancel (QD's
+        //! sloppy add, for N = 4)
+        static Expansion quickSum(const Expansion &a, const Expansion &b)
+        {
+          static_assert(N == 4, "Only quad-double has a quick sum");
+          double t0, t1, t2, t3;
+          const double s0 = twoSum(a.x_[0], b.x_[0], t0);
+          double s1 = twoSum(a.x_[1], b.x_[1], t1),
+                 s2 = twoSum(a.x_[2], b.x_[2], t2),
+                 s3 = twoSum(a.x_[3], b.x_[3], t3);
+          s1 = twoSum(s1, t0, t0);
+          threeSum(s2, t0, t1);
+          threeSum2(s3, t0, t2);
+          double t[5] = {s0, s1, s2, s3, t0 + t1 + t3};
+          return renormalizeOrdered(t, 5);
+        }
+
+        //! product
+        friend Expansion operator*(const Expansion &a, const Expansion &b)
+        {
+          if (!std::isfinite(a.x_[0] * b.x_[0])) return a.x_[0] * b.x_[0];
+          if constexpr (N == 2) {
+            double cl1;
+            const double ch = twoProd(a.x_[0], b.x_[0], cl1),
+                         tl = std::fma(a.x_[0], b.x_[1], a.x_[1] * b.x_[1]),
+                         cl2 = std::fma(a.x_[1], b.x_[0], tl);
+            double zl;
+            const double zh = fastTwoSum(ch, cl1 + cl2, zl);
+            const double z[2] = {zh, zl};
+            return fromNormalized(z);
+          }
+          else if constexpr (N == 4) {
+
+            // products of levels 0 to 2 with their errors, gathered level by
+            // level with three-sums, and rounded products of level 3
+            const double *x = a.x_,
+                         *y = b.x_;
+            double q0, q1, q2, q3, q4, q5;
+            double p0 = twoProd(x[0], y[0], q0),
+                   p1 = twoProd(x[0], y[1], q1),
+                   p2 = twoProd(x[1], y[0], q2),
+                   p3 = twoProd(x[0], y[2], q3),
+                   p4 = twoProd(x[1], y[1], q4),
+                   p5 = twoProd(x[2], y[0], q5);
+            threeSum(p1, p2, q0);
+            threeSum(p2, q1, q2);
+            threeSum(p3, p4, p5);
+            double t0, t1;
+            double s0 = twoSum(p2, p3, t0),
+                   s1 = twoSum(q1, p4, t1),
+                   s2 = q2 + p5;
+            s1 = twoSum(s1, t0, t0);
+            s2 += t0 + t1;
+            s1 += x[0] * y[3] + x[1] * y[2] + x[2] * y[1] + x[3] * y[0] + q0 + q3 + q4 + q5;
+            double t[5] = {p0, p1, s0, s1, s2};
+            return renormalizeOrdered(t, 5);
+          }
+          else {
+
+            // products a_i b_j of level l = i + j < N, whose errors are of
+            // level l + 1, then rounded products of level N, gathered level
+            // by level
+            double p[N][N] = {},
+                   e[N][N] = {};
+            for(unsigned int i = 0; i < N; i++) {
+              for(unsigned int j = 0; i + j < N; j++) p[i][j] = twoProd(a.x_[i], b.x_[j], e[i][j]);
+            }
+            double t[N * (N + 1) + N - 1];
+            unsigned int m = 0;
+            for(unsigned int l = 0; l <= N; l++) {
+              for(unsigned int i = 0; i <= l; i++) {
+                if (l < N) t[m++] = p[i][l - i];
+                else if (0 < i and i < N) t[m++] = a.x_[i] * b.x_[l - i];
+              }
+              for(unsigned int i = 0; i < l; i++) t[m++] = e[i][l - 1 - i];
+            }
+            return renormalize(t, m);
+          }
+        }
+
+        //! product with a double
+        friend Expansion operator*(const Expansion &a, const double b)
+        {
+          if (!std::isfinite(a.x_[0] * b)) return a.x_[0] * b;
+          if constexpr (N == 2) {
+            double cl1, zl;
+            const double ch = twoProd(a.x_[0], b, cl1),
+                         zh = fastTwoSum(ch, std::fma(a.x_[1], b, cl1), zl);
+            const double z[2] = {zh, zl};
+            return fromNormalized(z);
+          }
+          else if constexpr (N == 4) {
+            double q0, q1, q2;
+            const double p0 = twoProd(a.x_[0], b, q0),
+                         p1 = twoProd(a.x_[1], b, q1);
+            double p2 = twoProd(a.x_[2], b, q2),
+                   s2;
+            const double s1 = twoSum(q0, p1, s2);
+            threeSum(s2, q1, p2);
+            threeSum2(q1, q2, a.x_[3] * b);
+            double t[5] = {p0, s1, s2, q1, q2 + p2};
+            return renormalizeOrdered(t, 5);
+          }
+          else {
+            double t[2 * N];
+            for(unsigned int k = 0; k < N; k++) t[2 * k] = twoProd(a.x_[k], b, t[2 * k + 1]);
+            return renormalize(t, 2 * N);
+          }
+        }
+
+        //! quotient
+        friend Expansion operator/(const Expansion &a, const Expansion &b)
+        {
+          if (!std::isfinite(a.x_[0] / b.x_[0])) return a.x_[0] / b.x_[0];
+          if constexpr (N == 2) {
+
+            // th = a / b rounded, with the remainder a - b th found to
+            // double-word precision
+            const double th = a.x_[0] / b.x_[0];
+            const Expansion r = b * th;
+            double pl;
+            const double ph = twoSum(a.x_[0], -r.x_[0], pl),
+                         dl = (pl - r.x_[1]) + a.x_[1],
+                         tl = (ph + dl) / b.x_[0];
+            double zl;
+            const double zh = fastTwoSum(th, tl, zl);
+            const double z[2] = {zh, zl};
+            return fromNormalized(z);
+          }
+          else if constexpr (N == 4) {
+
+            // three steps of long division, one double of quotient at a time
+            double q[N];
+            Expansion r = a;
+            for(unsigned int k = 0; k < N; k++) {
+              q[k] = r.x_[0] / b.x_[0];
+              if (k + 1 < N) r = quickSum(r, -(b * q[k]));
+            }
+            return renormalizeOrdered(q, N);
+          }
+          else {
+
+            // long division, one double of quotient at a time
+            double q[N + 1];
+            Expansion r = a;
+            for(unsigned int k = 0; k <= N; k++) {
+              q[k] = r.x_[0] / b.x_[0];
+              if (k < N) r = r - b * q[k];
+            }
+            return renormalize(q, N + 1);
+          }
+        }
+
+        //! quotient by a double
+        friend Expansion operator/(const Expansion &a, const double b)
+        {
+          if (!std::isfinite(a.x_[0] / b)) return a.x_[0] / b;
+          if constexpr (N == 2) {
+
+            // th = a / b rounded, with the remainder a - b th exact up to
+            // the trailing component of a
+            const double th = a.x_[0] / b;
+            double pl;
+            const double ph = twoProd(th, b, pl),
+                         tl = (((a.x_[0] - ph) - pl) + a.x_[1]) / b;
+            double zl;
+            const double zh = fastTwoSum(th, tl, zl);
+            const double z[2] = {zh, zl};
+            return fromNormalized(z);
+          }
+          else {
+
+            // long division, whose remainders drop an exact product each,
+            // in three steps for N = 4
+            constexpr unsigned int steps = N == 4 ? N : N + 1;
+            double q[steps];
+            Expansion r = a;
+            for(unsigned int k = 0; k < steps; k++) {
+              q[k] = r.x_[0] / b;
+              if (k + 1 < steps) {
+                double p[N] = {};
+                p[0] = twoProd(-q[k], b, p[1]);
+                if constexpr (N == 4) r = quickSum(r, fromNormalized(p));
+                else r += fromNormalized(p);
+              }
+            }
+            if constexpr (N == 4) return renormalizeOrdered(q, steps);
+            else return renormalize(q, steps);
+          }
+        }
+
+        //! mixed and compound arithmetic
+        friend Expansion operator+(const Expansion &a, const double b) {return a + Expansion(b);}
+        friend Expansion operator+(const double a, const Expansion &b) {return Expansion(a) + b;}
+        friend Expansion operator-(const Expansion &a, const Expansion &b) {return a + -b;}
+        friend Expansion operator-(const Expansion &a, const double b) {return a + Expansion(-b);}
+        friend Expansion operator-(const double a, const Expansion &b) {return Expansion(a) + -b;}
+        friend Expansion operator*(const double a, const Expansion &b) {return b * a;}
+        friend Expansion operator/(const double a, const Expansion &b) {return Expansion(a) / b;}
+        Expansion& operator+=(const Expansion &b) {return *this = *this + b;}
+        Expansion& operator-=(const Expansion &b) {return *this = *this - b;}
+        Expansion& operator*=(const Expansion &b) {return *this = *this * b;}
+        Expansion& operator/=(const Expansion &b) {return *this = *this / b;}
+
+        //! comparisons, component by component from the leading one, as
+        //! normalized expansions don't overlap, so the first that differ
+        //! decide, and nan compares false as the leading component does
+        friend bool operator<(const Expansion &a, const Expansion &b)
+        {
+          unsigned int k = 0;
+          while (k + 1 < N and a.x_[k] == b.x_[k]) k++;
+          return a.x_[k] < b.x_[k];
+        }
+        friend bool operator>(const Expansion &a, const Expansion &b) {return b < a;}
+        friend bool operator<=(const Expansion &a, const Expansion &b)
+        {
+          unsigned int k = 0;
+          while (k + 1 < N and a.x_[k] == b.x_[k]) k++;
+          return a.x_[k] <= b.x_[k];
+        }
+        friend bool operator>=(const Expansion &a, const Expansion &b) {return b <= a;}
+        friend bool operator==(const Expansion &a, const Expansion &b)
+        {
+          for(unsigned int k = 0; k < N; k++) {
+            if (!(a.x_[k] == b.x_[k])) return false;
+          }
+          return true;
+        }
+        friend bool operator!=(const Expansion &a, const Expansion &b) {return !(a == b);}
+        friend bool operator<(const Expansion &a, const double b) {return a < Expansion(b);}
+        friend bool operator<(const double a, const Expansion &b) {return Expansion(a) < b;}
+        friend bool operator>(const Expansion &a, const double b) {return a > Expansion(b);}
+        friend bool operator>(const double a, const Expansion &b) {return Expansion(a) > b;}
+        friend bool operator<=(const Expansion &a, const double b) {return a <= Expansion(b);}
+        friend bool operator<=(const double a, const Expansion &b) {return Expansion(a) <= b;}
+        friend bool operator>=(const Expansion &a, const double b) {return a >= Expansion(b);}
+        friend bool operator>=(const double a, const Expansion &b) {return Expansion(a) >= b;}
+        friend bool operator==(const Expansion &a, const double b) {return a == Expansion(b);}
+        friend bool operator==(const double a, const Expansion &b) {return Expansion(a) == b;}
+        friend bool operator!=(const Expansion &a, const double b) {return !(a == b);}
+        friend bool operator!=(const double a, const Expansion &b) {return !(a == b);}
+
+        //! spacing of numbers near 1
+        static double epsilon() {return std::ldexp(1., -52 * static_cast<int>(N));}
+
+        //! from N components that are already normalized
+        static Expansion fromNormalized(const double *c)
+        {
+          Expansion z;
+          std::copy(c, c + N, z.x_);
+          return z;
+        }
+
+    };
+
+    //! leading components of pi / 2 and log(2)
+    constexpr double PI_2[4] = {0x1.921fb54442d18p+0, 0x1.1a62633145c07p-54,
+                                -0x1.f1976b7ed8fbcp-110, 0x1.4cf98e804177dp-164},
+                     LN2[4] = {0x1.62e42fefa39efp-1, 0x1.abc9e3b39803fp-56,
+                               0x1.7b57a079a1934p-111, -0x1.ace93a4ebe5d1p-165};
+
+    //! a 2^e, exact unless a component leaves the range of double
+    template <unsigned int N>
+    Expansion<N> ldexp(const Expansion<N> &a, const int e)
+    {
+      double c[N];
+      for(unsigned int k = 0; k < N; k++) c[k] = std::ldexp(a[k], e);
+      return Expansion<N>::fromNormalized(c);
+    }
+
+    //! classification, by the leading component
+    template <unsigned int N>
+    bool isfinite(const Expansion<N> &a) {return std::isfinite(a[0]);}
+    template <unsigned int N>
+    bool isnan(const Expansion<N> &a) {return std::isnan(a[0]);}
+    template <unsigned int N>
+    bool isinf(const Expansion<N> &a) {return std::isinf(a[0]);}
+
+    //! absolute value
+    template <unsigned int N>
+    Expansion<N> abs(const Expansion<N> &a) {return a[0] < 0 ? -a : a;}
+    template <unsigned int N>
+    Expansion<N> fabs(const Expansion<N> &a) {return abs(a);}
+
+    //! square root, by newton steps from the double one, which divide by
+    //! the double 2 y_0, as good as 2 y to the size of the correction, so
+    //! each adds 53 correct bits for a product and a sum
+    template <unsigned int N>
+    Expansion<N> sqrt(const Expansion<N> &a)
+    {
+      if (!(0 < a[0]) or !std::isfinite(a[0])) return std::sqrt(a[0]);
+      const double y0 = std::sqrt(a[0]);
+      Expansion<N> y = y0;
+      for(unsigned int bits = 53; bits < 52 * N; bits += 53) y += (a - y * y) / (2 * y0);
+      return y;
+    }
+
+    //! modulus of a complex expansion, scaled by a power of 2 so its squares
+    //! neither overflow nor underflow, which takes a square root where the
+    //! generic std::abs takes two quotients as well
+    template <unsigned int N>
+    Expansion<N> abs(const std::complex<Expansion<N>> &z)
+    {
+      const double m = std::max(std::abs(z.real()[0]), std::abs(z.imag()[0]));
+      if (m == 0 or !std::isfinite(m)) return m;
+      const int e = std::ilogb(m);
+      const Expansion<N> x = ldexp(z.real(), -e),
+                         y = ldexp(z.imag(), -e);
+      return ldexp(sqrt(x * x + y * y), e);
+    }
+
+    //! e^a, from s = e^r - 1 with a = k log(2) + 2^8 r, |r| <= log(2) / 2^9,
+    //! by its taylor series, then squared up to e^(2^8 r) - 1 as 2 s + s^2
+    template <unsigned int N>
+    Expansion<N> exp(const Expansion<N> &a)
+    {
+      if (!(a[0] < 710)) return std::exp(a[0]);
+      if (a[0] < -746) return 0;
+      constexpr int halvings = 8;
+      const double k = std::nearbyint(a[0] / M_LN2);
+      const Expansion<N> r = ldexp(a - Expansion<N>::fromNormalized(LN2) * k, -halvings);
+      Expansion<N> s = r,
+                   term = r;
+      for(unsigned int i = 2; std::abs(term[0]) > Expansion<N>::epsilon() * std::abs(s[0]); i++) {
+        term = term * r / static_cast<double>(i);
+        s += term;
+      }
+      for(int i = 0; i < halvings; i++) s = ldexp(s, 1) + s * s;
+      return ldexp(s + 1., static_cast<int>(k));
+    }
+
+    //! natural log, by newton steps y <- y + a e^-y - 1 from the double one
+    template <unsigned int N>
+    Expansion<N> log(const Expansion<N> &a)
+    {
+      if (!(0 < a[0]) or !std::isfinite(a[0])) return std::log(a[0]);
+      Expansion<N> y = std::log(a[0]);
+      for(unsigned int bits = 53; bits < 52 * N; bits *= 2) y += a * exp(-y) - 1;
+      return y;
+    }
+
+    //! base 2 exponential and log
+    template <unsigned int N>
+    Expansion<N> exp2(const Expansion<N> &a) {return exp(a * Expansion<N>::fromNormalized(LN2));}
+    template <unsigned int N>
+    Expansion<N> log2(const Expansion<N> &a) {return log(a) / Expansion<N>::fromNormalized(LN2);}
+
+    //! a^b for a > 0 (or a = 0 and b > 0)
+    template <unsigned int N>
+    Expansion<N> pow(const Expansion<N> &a, const Expansion<N> &b)
+    {
+      if (a[0] == 0) return b[0] > 0 ? 0 : std::pow(0., b[0]);
+      return exp(b * log(a));
+    }
+
+    //! sine and cosine, from those of r with a = k pi / 2 + r,
+    //! |r| <= pi / 4, by their taylor series
+    template <unsigned int N>
+    void sincos(const Expansion<N> &a, Expansion<N> &s, Expansion<N> &c)
+    {
+      if (!std::isfinite(a[0])) {s = c = std::sin(a[0]); return;}
+      const double k = std::nearbyint(a[0] / M_PI_2);
+      const Expansion<N> r = a - Expansion<N>::fromNormalized(PI_2) * k;
+      Expansion<N> sr = r,
+                   cr = 1,
+                   term = r;
+      for(unsigned int i = 2; std::abs(term[0]) > Expansion<N>::epsilon() * std::abs(sr[0]) or
+          std::abs(term[0]) > Expansion<N>::epsilon(); i += 2) {
+        term = -term * r / static_cast<double>(i);
+        cr += term;
+        term = term * r / static_cast<double>(i + 1);
+        sr += term;
+      }
+      switch (static_cast<long long>(std::fmod(k, 4.)) & 3) {
+        case 0: s = sr; c = cr; break;
+        case 1: s = cr; c = -sr; break;
+        case 2: s = -sr; c = -cr; break;
+        default: s = -cr; c = sr; break;
+      }
+    }
+    template <unsigned int N>
+    Expansion<N> sin(const Expansion<N> &a) {Expansion<N> s, c; sincos(a, s, c); return s;}
+    template <unsigned int N>
+    Expansion<N> cos(const Expansion<N> &a) {Expansion<N> s, c; sincos(a, s, c); return c;}
+
+    //! angle of (x, y), by newton steps on x sin(z) - y cos(z) = 0 from
+    //! the double one
+    template <unsigned int N>
+    Expansion<N> atan2(const Expansion<N> &y, const Expansion<N> &x)
+    {
+      Expansion<N> z = std::atan2(y[0], x[0]);
+      if (!std::isfinite(z[0]) or (x[0] == 0 and y[0] == 0)) return z;
+      for(unsigned int bits = 53; bits < 52 * N; bits *= 2) {
+        Expansion<N> s, c;
+        sincos(z, s, c);
+        z -= (x * s - y * c) / (x * c + y * s);
+      }
+      return z;
+    }
+  }
+
+  //! about 106 bits of precision at a few times the cost of double
+  using DoubleDouble = dd::Expansion<2>;
+
+  //! about 210 bits of precision
+  using QuadDouble = dd::Expansion<4>;
+
+  //! <cmath> functions, so that code generic in its real type calls them
+  //! unqualified, finding those of expansions by argument-dependent lookup
+  using std::abs;
+  using std::fabs;
+  using std::sqrt;
+  using std::exp;
+  using std::log;
+  using std::exp2;
+  using std::log2;
+  using std::pow;
+  using std::sin;
+  using std::cos;
+  using std::atan2;
+  using std::ldexp;
+  using std::isfinite;
+  using std::isnan;
+  using std::isinf;
+}
+
+namespace std
+{
+
+  //----------------------------------------------------------------------------//
+  //! limits of expansions, whose trailing components must stay normal
+  //----------------------------------------------------------------------------//
+  template <unsigned int N>
+  class numeric_limits<aberth::dd::Expansion<N>>
+  {
+    public:
+      static constexpr bool is_specialized = true;
+      static constexpr bool is_signed = true;
+      static constexpr bool is_integer = false;
+      static constexpr bool is_exact = false;
+      static constexpr bool has_infinity = true;
+      static constexpr bool has_quiet_NaN = true;
+      static constexpr int radix = 2;
+      static constexpr int digits = 52 * N + 1;
+      static constexpr int digits10 = (digits - 1) * 30103 / 100000;
+      static constexpr int max_exponent = DBL_MAX_EXP;
+      static constexpr int min_exponent = DBL_MIN_EXP + 53 * (N - 1);
+      static aberth::dd::Expansion<N> epsilon() {return aberth::dd::Expansion<N>::epsilon();}
+      static aberth::dd::Expansion<N> min() {return std::ldexp(1., min_exponent - 1);}
+      static aberth::dd::Expansion<N> max() {return DBL_MAX;}
+      static aberth::dd::Expansion<N> lowest() {return -DBL_MAX;}
+      static aberth::dd::Expansion<N> infinity() {return HUGE_VAL;}
+      static aberth::dd::Expansion<N> quiet_NaN() {return std::numeric_limits<double>::quiet_NaN();}
+  };
+}
+
+#endif  // #ifndef _ABERTH_DD_H_
@@ -0,0 +1,375 @@
+/* Aberth's method for polynomials whose degree is known at compile time */
+#ifndef _ABERTH_FIXED_H_
+#define _ABERTH_FIXED_H_
+
+// includes, system
+#include <array>
+#include <complex>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+
+// includes, project
+#include "aberth_rng.h"
+
+namespace aberth
+{
+
+  //----------------------------------------------------------------------------//
+  //! call f(std::integral_constant<unsigned int, k>()) for k = 0, 1, ..., K - 1
+  //! a fold expression, so that loops over a fixed degree are fully unrolled
+  //----------------------------------------------------------------------------//
+  template <unsigned int... K, typename F>
+  inline __attribute__((always_inline))
+  void unroll(std::integer_sequence<unsigned int, K...>, F &&f)
+  {
+    (f(std::integral_constant<unsigned int, K>()), ...);
+  }
+
+  //----------------------------------------------------------------------------//
+  //! Zero finder for polynomials of degree N, fixed at compile time
+  //! same iteration as the default settings of ZeroFinder<T> (Jacobi sweeps,
+  //! exact sums and the test |p| < tol), so with scalar sums it finds the same
+  //! zeros bit for bit, but data are held in std::array, loops over the degree
+  //! are unrolled and nothing is allocated, which pays off for tiny degrees
+  //----------------------------------------------------------------------------//
+  template <typename T, unsigned int N>
+  class FixedZeroFinder
+  {
+    static_assert(1 <= N, "Degree of polynomial must be at least 1");
+
+    //**************************************//
+    // data members
+    //**************************************//
+
+    protected:
+
+      //! methods for initializing zeros, as named in ZeroFinder<T>
+      enum class InitMode {rand, symm, newton};
+
+      //! coefficients, from constant to leading
+      std::array<std::complex<T>, N + 1> coeffs_;
+
+      //! (not necessarily converged) zeros of polynomial
+      std::array<std::complex<T>, N> zeros_;
+
+      //! tolerance for calculation
+      T tol_;
+
+      //! maximum number of iterations
+      unsigned int maxIters_;
+
+      //! method for initializing zeros
+      InitMode initMode_;
+
+      //! p' / p at current zeros
+      std::array<std::complex<T>, N> logDeriv_;
+
+      //! |p| at current zeros
+      std::array<T, N> resid_;
+
+      //! summed reciprocal differences of zeros
+      std::array<std::complex<T>, N> invDiffSum_;
+
+      //! whether or not individual zeros are converged to within tol
+      std::array<bool, N> conv_;
+
+      //! number of iterations performed
+      unsigned int iters_;
+
+      //! whether or not all zeros are converged
+      bool allConv_;
+
+      //! whether or not values of p or its reverse may need rescaling
+      bool rescale_;
+
+      //! stream of random numbers for "rand" and "symm" guesses
+      SplitMix rng_;
+
+    //**************************************//
+    // member functions
+    //**************************************//
+
+    public:
+
+      //! non-default constructor
+      //! initMode is one of "rand", "symm" or "newton", as for ZeroFinder<T>
+      explicit FixedZeroFinder(const std::array<std::complex<T>, N + 1> &coeffs,
+          const T tol = 1e-9,
+          const unsigned int maxIters = 200,
+          const char *initMode = "rand") :
+        tol_(tol),
+        maxIters_(maxIters)
+      {
+
+        // tolerance must be above smallest positive double
+        assert(DBL_MIN <= tol and "tol must be at least DBL_MIN");
+
+        // only three methods of initializing zeros
+        if (!strcmp(initMode, "rand")) initMode_ = InitMode::rand;
+        else if (!strcmp(initMode, "symm")) initMode_ = InitMode::symm;
+        else {
+          assert(!strcmp(initMode, "newton") and
+              "initMode must be either 'rand', 'symm' or 'newton'");
+          initMode_ = InitMode::newton;
+        }
+
+        reset(coeffs.data());
+      }
+
+      //! start over with a new polynomial given by N + 1 coeffs
+      void reset(const std::complex<T> *coeffs)
+      {
+        std::copy(coeffs, coeffs + N + 1, coeffs_.begin());
+
+        // p and its reverse are only evaluated at |x| <= 1, where
+        // |p'| <= N sum |a_k|, so values stay below the threshold at which
+        // evalDerivScaled rescales them unless the coeffs are huge
+        T sum = 0;
+        for (const auto &coeffsI : coeffs_) sum += std::abs(coeffsI.real()) + std::abs(coeffsI.imag());
+        rescale_ = !(N * sum < std::ldexp(static_cast<T>(1),
+              std::numeric_limits<T>::max_exponent / 2 - 1));
+        initZeros();
+        for(unsigned int i = 0; i < N; i++) compLogDeriv(i);
+        conv_.fill(false);
+        iters_ = 0;
+        allConv_ = false;
+      }
+
+      //! start over from guesses drawn from the stream of seed
+      void setSeed(const uint64_t seed)
+      {
+        rng_.seed(seed);
+        reset(coeffs_.data());
+      }
+
+      //! use Aberth's method to approximate zeros
+      //! returns true iff all zeros have converged to within tol_
+      bool compZeros()
+      {
+        for(; iters_ < maxIters_ and !allConv_; iters_++) {
+          compInvDiffSum();
+          allConv_ = newtonStep() == N;
+        }
+        sortZeros();
+        return allConv_;
+      }
+
+      //! return (not necessarily converged) zeros of polynomial
+      const std::array<std::complex<T>, N>& getZeros() const {return zeros_;}
+
+      //! return number of iterations performed
+      unsigned int getIters() const {return iters_;}
+
+      //! return largest residual |p| at current zeros
+      T getMaxResid() const {return *std::max_element(resid_.cbegin(), resid_.cend());}
+
+    protected:
+
+      //! evaluate p (or its reverse if Rev) and its derivative at x, both
+      //! scaled by 2^-exp, as in Polynomial<T>::evalDerivScaled
+      //! values are only rescaled if they might grow large, and otherwise
+      //! Horner's method is a straight line of N steps
+      //! returns exp
+      template <bool Rev>
+      int evalDerivScaled(const std::complex<T> x,
+          std::complex<T> &val,
+          std::complex<T> &deriv) const
+      {
+        val = coeffs_[Rev ? 0 : N];
+        deriv = 0;
+        if (!rescale_) {
+          unroll(std::make_integer_sequence<unsigned int, N>(), [&](auto k) __attribute__((always_inline)) {
+            deriv = val + deriv*x;
+            val = val*x + coeffs_[Rev ? k + 1 : N - 1 - k];
+          });
+          return 0;
+        }
+
+        constexpr int shift = std::numeric_limits<T>::max_exponent / 2;
+        const T big = std::ldexp(static_cast<T>(1), shift);
+        int exp = 0;
+        for(unsigned int k = 0; k < N; k++) {
+          const std::complex<T> &c = coeffs_[Rev ? k + 1 : N - 1 - k];
+          deriv = val + deriv*x;
+          val = val*x + (exp ? std::complex<T>(std::ldexp(c.real(), -exp),
+                std::ldexp(c.imag(), -exp)) : c);
+          if (big < std::max(std::max(std::abs(val.real()), std::abs(val.imag())),
+                std::max(std::abs(deriv.real()), std::abs(deriv.imag())))) {
+            val = {std::ldexp(val.real(), -shift), std::ldexp(val.imag(), -shift)};
+            deriv = {std::ldexp(deriv.real(), -shift), std::ldexp(deriv.imag(), -shift)};
+            exp += shift;
+          }
+        }
+        return exp;
+      }
+
+      //! evaluate p' / p and |p| at the ith zero, with the reverse
+      //! polynomial outside the unit circle, as in ZeroFinder<T>::compLogDeriv
+      void compLogDeriv(const unsigned int i)
+      {
+        std::complex<T> val,
+                        deriv;
+        const T mag = abs(zeros_[i]);
+        if (mag < 1) {
+          const int exp = evalDerivScaled<false>(zeros_[i], val, deriv);
+          logDeriv_[i] = deriv / val;
+          resid_[i] = std::ldexp(abs(val), exp);
+        }
+        else {
+          const std::complex<T> gamma = static_cast<std::complex<T>>(1) / zeros_[i];
+          const int exp = evalDerivScaled<true>(gamma, val, deriv);
+          logDeriv_[i] = static_cast<std::complex<T>>(N) * gamma -
+            (gamma * gamma * deriv / val);
+          resid_[i] = std::exp2(std::log2(abs(val)) + exp + N * std::log2(mag));
+        }
+      }
+
+      //! compute sums of 1 / (z_i - z_j) over j != i
+      //! 1 / (z_i - z_j) = -1 / (z_j - z_i), so each difference is inverted
+      //! once, and each sum still gets its terms in increasing j, as from
+      //! the scalar kernel of invDiffSumRow
+      void compInvDiffSum()
+      {
+        std::array<T, N> sRe = {},
+                         sIm = {};
+        unroll(std::make_integer_sequence<unsigned int, N>(), [&](auto i) __attribute__((always_inline)) {
+          unroll(std::make_integer_sequence<unsigned int, N - 1 - decltype(i)::value>(), [&](auto l) __attribute__((always_inline)) {
+            constexpr unsigned int j = decltype(i)::value + 1 + decltype(l)::value;
+            const T dRe = zeros_[i].real() - zeros_[j].real(),
+                    dIm = zeros_[i].imag() - zeros_[j].imag(),
+                    inv = static_cast<T>(1) / (dRe * dRe + dIm * dIm),
+                    rRe = dRe * inv,
+                    rIm = dIm * inv;
+            sRe[i] += rRe; sIm[i] -= rIm;
+            sRe[j] -= rRe; sIm[j] += rIm;
+          });
+        });
+        for(unsigned int i = 0; i < N; i++) invDiffSum_[i] = {sRe[i], sIm[i]};
+      }
+
+      //! update all zeros with a Newton step, as in ZeroFinder<T>::newtonStep
+      //! returns the number of converged zeros
+      unsigned int newtonStep()
+      {
+        unsigned int nConv = 0;
+        for(unsigned int i = 0; i < N; i++) {
+          zeros_[i] -= static_cast<std::complex<T>>(1) / (logDeriv_[i] - invDiffSum_[i]);
+          compLogDeriv(i);
+          if (!conv_[i] and resid_[i] < tol_) conv_[i] = true;
+          if (conv_[i]) nConv++;
+        }
+        return nConv;
+      }
+
+      //! compute initial guesses for zeros, drawing from this finder's stream
+      //! as ZeroFinder<T>::initZeros does
+      void initZeros()
+      {
+        if (initMode_ == InitMode::newton) {newtonPolygonZeros(); return;}
+
+        // cauchy bound on roots' magnitude
+        T rMax = 0;
+        const T lead = abs(coeffs_[N]);
+        for (const auto &coeffsI : coeffs_) rMax = std::max(rMax, abs(coeffsI) / lead);
+        rMax += static_cast<T>(1);
+
+        // two uniform draws for each random guess
+        std::array<T, 2 * N> draws;
+        rng_.fill(draws.data(), initMode_ == InitMode::rand ? 2 * N : 2);
+
+        std::complex<T> z;
+        for(unsigned int i = 0; i < N; i++) {
+          if (initMode_ == InitMode::rand or !i) {
+            const T a = rMax * draws[2 * i],
+                    b = sqrt(rMax*rMax - a*a) * draws[2 * i + 1];
+            z = {a, b};
+          }
+          else z = (z * z) / abs(z);
+          zeros_[i] = z;
+        }
+      }
+
+      //! place guesses on circles from the upper convex hull of (i, log|a_i|),
+      //! as in ZeroFinder<T>::newtonPolygonZeros
+      void newtonPolygonZeros()
+      {
+        const T twoPi = static_cast<T>(2 * M_PI),
+                sigma = static_cast<T>(0.7);
+
+        // upper convex hull of points with nonzero coeffs
+        std::array<unsigned int, N + 1> hull;
+        std::array<T, N + 1> logs;
+        unsigned int size = 0;
+        for(unsigned int i = 0; i <= N; i++) {
+          if (coeffs_[i] == static_cast<std::complex<T>>(0)) continue;
+          logs[i] = std::log(abs(coeffs_[i]));
+          while (2 <= size) {
+            const unsigned int j = hull[size - 1],
+                               k = hull[size - 2];
+            if ((logs[j] - logs[k]) * (i - k) <= (logs[i] - logs[k]) * (j - k)) size--;
+            else break;
+          }
+          hull[size++] = i;
+        }
+
+        // m guesses on the circle of radius r, from the ith zero on
+        auto circle = [this, twoPi](const unsigned int i, const unsigned int m,
+            const T r, const T angle) {
+          for(unsigned int j = 0; j < m; j++) zeros_[i + j] = std::polar(r, twoPi * j / m + angle);
+        };
+
+        // smallest radius of the hull
+        T rMin = 1;
+        for(unsigned int e = 0; e + 1 < size; e++) {
+          const T r = std::exp((logs[hull[e]] - logs[hull[e + 1]]) / (hull[e + 1] - hull[e]));
+          if (!e or r < rMin) rMin = r;
+        }
+
+        // zeros at the origin start where |p| is already below tol
+        if (hull[0]) {
+          const T r = std::min(rMin, std::pow(tol_ / abs(coeffs_[hull[0]]),
+                static_cast<T>(1) / hull[0])) / 2;
+          circle(0, hull[0], r, sigma);
+        }
+
+        // guesses on the circle of each edge
+        for(unsigned int e = 0; e + 1 < size; e++) {
+          const unsigned int m = hull[e + 1] - hull[e];
+          const T r = std::exp((logs[hull[e]] - logs[hull[e + 1]]) / m);
+          circle(hull[e], m, r, twoPi * hull[e] / N + sigma);
+        }
+      }
+
+      //! sort zeros and their data by magnitude, breaking ties as
+      //! ZeroFinder<T>::sortZeros does
+      void sortZeros()
+      {
+        std::array<unsigned int, N> perm;
+        for(unsigned int i = 0; i < N; i++) perm[i] = i;
+        std::sort(perm.begin(), perm.end(), [this](const unsigned int v, const unsigned int w)
+            {const T absV = abs(zeros_[v]), absW = abs(zeros_[w]);
+             return absV < absW or (absV == absW and zeros_[w].imag() < zeros_[v].imag());});
+
+        const std::array<std::complex<T>, N> zeros = zeros_,
+                                             logDeriv = logDeriv_;
+        const std::array<T, N> resid = resid_;
+        const std::array<bool, N> conv = conv_;
+        for(unsigned int i = 0; i < N; i++) {
+          zeros_[i] = zeros[perm[i]];
+          logDeriv_[i] = logDeriv[perm[i]];
+          resid_[i] = resid[perm[i]];
+          conv_[i] = conv[perm[i]];
+        }
+      }
+
+  };
+}
+
+#endif  // #ifndef _ABERTH_FIXED_H_
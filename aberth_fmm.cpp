@@ -0,0 +1,302 @@
+// includes, system
+#include <vector>
+#include <complex>
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+// includes, project
+#include "aberth_fmm.h"
+#include "aberth_dd.h"
+
+namespace aberth
+{
+
+  //----------------------------------------------------------------------------//
+  //! non-default constructor
+  //! the truncated expansions of well separated boxes are accurate to about
+  //! 0.4^p relative to the sums, which sets the number of terms p
+  //! translation operators only depend on relative box positions, since
+  //! coeffs are scaled by box size, so they are computed here once
+  //! @param  tol  requested relative accuracy of the sums
+  //----------------------------------------------------------------------------//
+  CauchyFmm::CauchyFmm(const double tol) :
+    tol_(tol)
+  {
+    assert(0 < tol and tol < 1 and "tol must be in (0, 1)");
+
+    order_ = static_cast<unsigned int>(std::ceil(std::log(tol) / std::log(0.4))) + 1;
+    order_ = std::min(std::max(order_, 4u), 60u);
+    const unsigned int p = order_;
+
+    // Pascal's triangle
+    std::vector<std::vector<double>> binom(2 * p, std::vector<double>(2 * p, 0));
+    for (unsigned int k = 0; k < 2 * p; k++) {
+      binom[k][0] = 1;
+      for (unsigned int l = 1; l <= k; l++) binom[k][l] = binom[k - 1][l - 1] + binom[k - 1][l];
+    }
+
+    // powers of z
+    std::vector<std::complex<double>> pw(2 * p + 1);
+    auto powers = [&pw](const std::complex<double> z) {
+      pw[0] = 1;
+      for (unsigned int k = 1; k < pw.size(); k++) pw[k] = pw[k - 1] * z;
+    };
+
+    // child centers are offset by +-1/4 of the parent's size,
+    // and children are half the size of their parent
+    m2m_.assign(4 * p * p, 0);
+    l2l_.assign(4 * p * p, 0);
+    for (unsigned int q = 0; q < 4; q++) {
+      powers({(q % 2) ? 0.25 : -0.25, (q / 2) ? 0.25 : -0.25});
+      for (unsigned int k = 0; k < p; k++) {
+        for (unsigned int j = 0; j <= k; j++) {
+          m2m_[(q * p + k) * p + j] = binom[k][j] * std::ldexp(1., -j) * pw[k - j];
+          l2l_[(q * p + j) * p + k] = binom[k][j] * std::ldexp(1., -j) * pw[k - j];
+        }
+      }
+    }
+
+    // boxes in the interaction list are at least two boxes apart
+    m2l_.assign(49 * p * p, 0);
+    for (int oy = -3; oy <= 3; oy++) {
+      for (int ox = -3; ox <= 3; ox++) {
+        if (std::abs(ox) <= 1 and std::abs(oy) <= 1) continue;
+        const unsigned int o = (oy + 3) * 7 + ox + 3;
+        powers(1. / std::complex<double>(ox, oy));
+        for (unsigned int j = 0; j < p; j++) {
+          for (unsigned int k = 0; k < p; k++) {
+            m2l_[(o * p + j) * p + k] = (j % 2 ? -1. : 1.) * binom[k + j][j] * pw[k + j + 1];
+          }
+        }
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------//
+  //! requested relative accuracy
+  //----------------------------------------------------------------------------//
+  double CauchyFmm::getTol() const {return tol_;}
+
+  //----------------------------------------------------------------------------//
+  //! approximate sums of 1 / (z_i - z_j) over j != i
+  //! @param  re    real parts of zeros
+  //! @param  im    imag parts of zeros
+  //! @param  n     number of zeros
+  //! @param  sums  approximate sums
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  void CauchyFmm::compSums(const T *re,
+      const T *im,
+      const unsigned int n,
+      std::complex<T> *sums)
+  {
+    const unsigned int p = order_;
+    const std::complex<double> one = 1;
+
+    // direct sums are cheaper for few zeros
+    if (n < 8 * p) {
+      for (unsigned int i = 0; i < n; i++) {
+        std::complex<double> s = 0;
+        const std::complex<double> z = {static_cast<double>(re[i]),
+                                        static_cast<double>(im[i])};
+        for (unsigned int j = 0; j < n; j++) {
+          if (i != j) s += one / (z - std::complex<double>(static_cast<double>(re[j]),
+                                                 static_cast<double>(im[j])));
+        }
+        sums[i] = {static_cast<T>(s.real()), static_cast<T>(s.imag())};
+      }
+      return;
+    }
+
+    //**************************************//
+    // build the tree
+    //**************************************//
+
+    // square containing all zeros
+    double xMin = static_cast<double>(re[0]), xMax = xMin,
+           yMin = static_cast<double>(im[0]), yMax = yMin;
+    for (unsigned int i = 1; i < n; i++) {
+      xMin = std::min(xMin, static_cast<double>(re[i]));
+      xMax = std::max(xMax, static_cast<double>(re[i]));
+      yMin = std::min(yMin, static_cast<double>(im[i]));
+      yMax = std::max(yMax, static_cast<double>(im[i]));
+    }
+    double side = std::max(xMax - xMin, yMax - yMin);
+    side = side ? side * (1 + 1e-12) : 1;
+
+    // refine until nonempty leaves hold about 2p zeros on average,
+    // since zeros often lie on curves rather than fill the square
+    std::vector<unsigned int> &leaf = leaf_;
+    leaf.resize(n);
+    unsigned int levels = 1,
+                 nb;
+    do {
+      levels++;
+      nb = 1u << levels;
+      leafStart_.assign(nb * nb + 1, 0);
+      for (unsigned int i = 0; i < n; i++) {
+        const unsigned int ix = std::min(nb - 1,
+            static_cast<unsigned int>((static_cast<double>(re[i]) - xMin) / side * nb)),
+                           iy = std::min(nb - 1,
+            static_cast<unsigned int>((static_cast<double>(im[i]) - yMin) / side * nb));
+        leaf[i] = iy * nb + ix;
+        leafStart_[leaf[i] + 1]++;
+      }
+    } while (levels < 9 and 2 * p * (nb * nb - static_cast<unsigned int>(
+            std::count(leafStart_.begin() + 1, leafStart_.end(), 0u))) < n);
+    for (unsigned int b = 0; b < nb * nb; b++) leafStart_[b + 1] += leafStart_[b];
+    points_.resize(n);
+    perm_.resize(n);
+    next_.assign(leafStart_.begin(), leafStart_.end() - 1);
+    for (unsigned int i = 0; i < n; i++) {
+      perm_[next_[leaf[i]]] = i;
+      points_[next_[leaf[i]]++] = {static_cast<double>(re[i]),
+                                   static_cast<double>(im[i])};
+    }
+
+    // center of box (x, y) at a level whose boxes have size h
+    auto center = [xMin, yMin](const unsigned int x, const unsigned int y,
+        const double h) {
+      return std::complex<double>(xMin + (x + 0.5) * h, yMin + (y + 0.5) * h);
+    };
+
+    multi_.resize(levels + 1);
+    local_.resize(levels + 1);
+    count_.resize(levels + 1);
+    for (unsigned int l = 2; l <= levels; l++) {
+      multi_[l].assign((1u << (2 * l)) * p, 0);
+      local_[l].assign((1u << (2 * l)) * p, 0);
+      count_[l].assign(1u << (2 * l), 0);
+    }
+
+    //**************************************//
+    // upward pass
+    //**************************************//
+
+    // multipole coeffs of leaves, scaled by the box size
+    const double hLeaf = side / nb;
+    for (unsigned int y = 0; y < nb; y++) {
+      for (unsigned int x = 0; x < nb; x++) {
+        const unsigned int b = y * nb + x;
+        count_[levels][b] = leafStart_[b + 1] - leafStart_[b];
+        const std::complex<double> c = center(x, y, hLeaf);
+        std::complex<double> *a = &multi_[levels][b * p];
+        for (unsigned int j = leafStart_[b]; j < leafStart_[b + 1]; j++) {
+          const std::complex<double> w = (points_[j] - c) / hLeaf;
+          std::complex<double> pw = 1;
+          for (unsigned int k = 0; k < p; k++) {a[k] += pw; pw *= w;}
+        }
+      }
+    }
+
+    // shift children's multipole coeffs to their parent
+    for (unsigned int l = levels - 1; 2 <= l; l--) {
+      const unsigned int m = 1u << l;
+      for (unsigned int b = 0; b < m * m; b++) {
+        const unsigned int x = b % m, y = b / m;
+        std::complex<double> *a = &multi_[l][b * p];
+        for (unsigned int q = 0; q < 4; q++) {
+          const unsigned int cb = (2 * y + q / 2) * 2 * m + 2 * x + q % 2;
+          if (!count_[l + 1][cb]) continue;
+          count_[l][b] += count_[l + 1][cb];
+          const std::complex<double> *ac = &multi_[l + 1][cb * p],
+                                     *op = &m2m_[q * p * p];
+          for (unsigned int k = 0; k < p; k++) {
+            for (unsigned int j = 0; j <= k; j++) a[k] += op[k * p + j] * ac[j];
+          }
+        }
+      }
+    }
+
+    //**************************************//
+    // downward pass
+    //**************************************//
+
+    for (unsigned int l = 2; l <= levels; l++) {
+      const unsigned int m = 1u << l;
+      const double h = side / m;
+      for (unsigned int b = 0; b < m * m; b++) {
+        if (!count_[l][b]) continue;
+        const int x = b % m, y = b / m;
+        std::complex<double> *bl = &local_[l][b * p];
+
+        // shift parent's local coeffs to this box
+        if (2 < l) {
+          const unsigned int pb = (y / 2) * (m / 2) + x / 2,
+                             q = (y % 2) * 2 + x % 2;
+          const std::complex<double> *bp = &local_[l - 1][pb * p],
+                                     *op = &l2l_[q * p * p];
+          for (unsigned int j = 0; j < p; j++) {
+            for (unsigned int k = j; k < p; k++) bl[j] += op[j * p + k] * bp[k];
+          }
+        }
+
+        // convert multipole coeffs of the interaction list
+        for (int sy = 2 * (y / 2) - 2; sy <= 2 * (y / 2) + 3; sy++) {
+          for (int sx = 2 * (x / 2) - 2; sx <= 2 * (x / 2) + 3; sx++) {
+            if (sx < 0 or sy < 0 or m <= static_cast<unsigned int>(sx) or
+                m <= static_cast<unsigned int>(sy)) continue;
+            if (std::abs(sx - x) <= 1 and std::abs(sy - y) <= 1) continue;
+            const unsigned int sb = sy * m + sx;
+            if (!count_[l][sb]) continue;
+
+            const unsigned int o = (y - sy + 3) * 7 + x - sx + 3;
+            const std::complex<double> *as = &multi_[l][sb * p],
+                                       *op = &m2l_[o * p * p];
+            for (unsigned int j = 0; j < p; j++) {
+              std::complex<double> acc = 0;
+              for (unsigned int k = 0; k < p; k++) acc += op[j * p + k] * as[k];
+              bl[j] += acc / h;
+            }
+          }
+        }
+      }
+    }
+
+    //**************************************//
+    // evaluation
+    //**************************************//
+
+    for (unsigned int b = 0; b < nb * nb; b++) {
+      if (leafStart_[b] == leafStart_[b + 1]) continue;
+      const int x = b % nb, y = b / nb;
+      const std::complex<double> c = center(x, y, hLeaf),
+                                 *bl = &local_[levels][b * p];
+      for (unsigned int i = leafStart_[b]; i < leafStart_[b + 1]; i++) {
+
+        // far field from local expansion
+        const std::complex<double> w = (points_[i] - c) / hLeaf;
+        std::complex<double> s = bl[p - 1];
+        for (unsigned int k = p - 1; k-- > 0;) s = s * w + bl[k];
+
+        // near field directly
+        for (int ny = std::max(y - 1, 0); ny <= std::min(y + 1, int(nb) - 1); ny++) {
+          for (int nx = std::max(x - 1, 0); nx <= std::min(x + 1, int(nb) - 1); nx++) {
+            const unsigned int nbx = ny * nb + nx;
+            for (unsigned int j = leafStart_[nbx]; j < leafStart_[nbx + 1]; j++) {
+              if (i != j) s += one / (points_[i] - points_[j]);
+            }
+          }
+        }
+
+        sums[perm_[i]] = {static_cast<T>(s.real()), static_cast<T>(s.imag())};
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------//
+  // specialization
+  //----------------------------------------------------------------------------//
+  template void CauchyFmm::compSums<float>(const float *, const float *,
+      const unsigned int, std::complex<float> *);
+  template void CauchyFmm::compSums<double>(const double *, const double *,
+      const unsigned int, std::complex<double> *);
+  template void CauchyFmm::compSums<long double>(const long double *,
+      const long double *, const unsigned int, std::complex<long double> *);
+  template void CauchyFmm::compSums<DoubleDouble>(const DoubleDouble *,
+      const DoubleDouble *, const unsigned int, std::complex<DoubleDouble> *);
+  template void CauchyFmm::compSums<QuadDouble>(const QuadDouble *,
+      const QuadDouble *, const unsigned int, std::complex<QuadDouble> *);
+
+}
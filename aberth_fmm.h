@@ -0,0 +1,85 @@
+/* Fast multipole method for sums of 1 / (z_i - z_j) */
+#ifndef _ABERTH_FMM_H_
+#define _ABERTH_FMM_H_
+
+// includes, system
+#include <vector>
+#include <complex>
+
+namespace aberth
+{
+
+  //----------------------------------------------------------------------------//
+  //! Fast multipole method for the 2D Cauchy kernel on a uniform quadtree
+  //! approximates s_i = sum of 1 / (z_i - z_j) over j != i in O(n p^2)
+  //! expansions are computed in double and scaled by their box's size
+  //----------------------------------------------------------------------------//
+  class CauchyFmm
+  {
+
+    //**************************************//
+    // data members
+    //**************************************//
+
+    protected:
+
+      //! requested relative accuracy
+      double tol_;
+
+      //! number of terms in expansions
+      unsigned int order_;
+
+      //! operators shifting multipole coeffs from a child to its parent,
+      //! one p x p matrix for each child position
+      std::vector<std::complex<double>> m2m_;
+
+      //! operators shifting local coeffs from a parent to its child
+      std::vector<std::complex<double>> l2l_;
+
+      //! operators converting multipole to local coeffs, one for each offset
+      //! of a box in the interaction list (in units of box size, up to +-3)
+      std::vector<std::complex<double>> m2l_;
+
+      //! points sorted by leaf
+      std::vector<std::complex<double>> points_;
+
+      //! index of each sorted point in the input
+      std::vector<unsigned int> perm_;
+
+      //! first sorted point of each leaf (one more entry than leaves)
+      std::vector<unsigned int> leafStart_;
+
+      //! leaf of each input point, and next free slot of each leaf
+      std::vector<unsigned int> leaf_,
+                                next_;
+
+      //! multipole and local coefficients, per level, box-major
+      std::vector<std::vector<std::complex<double>>> multi_,
+                                                     local_;
+
+      //! number of points in each box, per level
+      std::vector<std::vector<unsigned int>> count_;
+
+    //**************************************//
+    // member functions
+    //**************************************//
+
+    public:
+
+      //! non-default constructor
+      explicit CauchyFmm(const double tol = 1e-6);
+
+      //! requested relative accuracy
+      double getTol() const;
+
+      //! approximate sums for n zeros given as split arrays
+      template <typename T>
+      void compSums(const T *re,
+          const T *im,
+          const unsigned int n,
+          std::complex<T> *sums);
+
+  };
+}
+
+#endif  // #ifndef _ABERTH_FMM_H_
@@ -0,0 +1,338 @@
+// includes, system
+#include <cassert>
+
+// includes, project
+#include "aberth_pool.h"
+
+namespace aberth
+{
+
+  //----------------------------------------------------------------------------//
+  //! ThreadPool whose chunk the thread running this code is in, if any, so
+  //! that parallelFor called from within a chunk doesn't wait for threads
+  //! that are all busy
+  //----------------------------------------------------------------------------//
+  static thread_local const ThreadPool *chunkPool = nullptr;
+
+  //----------------------------------------------------------------------------//
+  //! non-default constructor
+  //! @param  nThreads  number of threads, including the calling thread
+  //----------------------------------------------------------------------------//
+  ThreadPool::ThreadPool(const unsigned int nThreads) :
+    job_(nullptr),
+    n_(0),
+    generation_(0),
+    pending_(0),
+    stop_(false)
+  {
+    assert(1 <= nThreads and "Pool must have at least one thread");
+
+    for (unsigned int c = 1; c < nThreads; c++) {
+      workers_.emplace_back(&ThreadPool::work, this, c);
+    }
+  }
+
+  //----------------------------------------------------------------------------//
+  //! join workers
+  //----------------------------------------------------------------------------//
+  ThreadPool::~ThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    start_.notify_all();
+    for (auto &worker : workers_) worker.join();
+  }
+
+  //----------------------------------------------------------------------------//
+  //! number of threads, including the calling thread
+  //----------------------------------------------------------------------------//
+  unsigned int ThreadPool::size() const {return workers_.size() + 1;}
+
+  //----------------------------------------------------------------------------//
+  //! first index of chunk c of [0, n)
+  //----------------------------------------------------------------------------//
+  unsigned int ThreadPool::chunkBegin(const unsigned int n,
+      const unsigned int c) const
+  {
+    return static_cast<unsigned long>(n) * c / size();
+  }
+
+  //----------------------------------------------------------------------------//
+  //! call fn(begin, end, chunk) for each of size() chunks of [0, n)
+  //! returns once every chunk is done
+  //! called from within a chunk of this pool, the other threads are busy
+  //! with their own chunks, so the calling thread runs every chunk itself
+  //----------------------------------------------------------------------------//
+  void ThreadPool::parallelFor(const unsigned int n,
+      const std::function<void(unsigned int, unsigned int, unsigned int)> &fn)
+  {
+    if (chunkPool == this) {
+      for (unsigned int c = 0; c < size(); c++) fn(chunkBegin(n, c), chunkBegin(n, c + 1), c);
+      return;
+    }
+    std::lock_guard<std::mutex> call(callMutex_);
+
+    // hand job to workers
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      job_ = &fn;
+      n_ = n;
+      pending_ = workers_.size();
+      generation_++;
+    }
+    start_.notify_all();
+
+    // calling thread takes the first chunk
+    const ThreadPool *outerPool = chunkPool;
+    chunkPool = this;
+    fn(chunkBegin(n, 0), chunkBegin(n, 1), 0);
+    chunkPool = outerPool;
+
+    // wait for the others
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] {return !pending_;});
+    job_ = nullptr;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! loop run by each worker
+  //! @param  chunk  index of the chunk this worker always takes
+  //----------------------------------------------------------------------------//
+  void ThreadPool::work(const unsigned int chunk)
+  {
+    chunkPool = this;
+    unsigned long seen = 0;
+    while (true) {
+
+      // wait for a new job
+      const std::function<void(unsigned int, unsigned int, unsigned int)> *job;
+      unsigned int n;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        start_.wait(lock, [this, seen] {return stop_ or generation_ != seen;});
+        if (stop_) return;
+        seen = generation_;
+        job = job_;
+        n = n_;
+      }
+
+      (*job)(chunkBegin(n, chunk), chunkBegin(n, chunk + 1), chunk);
+
+      // report completion
+      bool last;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        last = !--pending_;
+      }
+      if (last) done_.notify_one();
+    }
+  }
+
+  //----------------------------------------------------------------------------//
+  //! pool and index of the thread running this code, if it belongs to a
+  //! WorkStealingPool, so that parallelFor knows whose queue to use
+  //----------------------------------------------------------------------------//
+  static thread_local const WorkStealingPool *currentPool = nullptr;
+  static thread_local unsigned int currentThread = 0;
+
+  //----------------------------------------------------------------------------//
+  //! non-default constructor
+  //! the base pool is given a single thread, so it starts none of its own
+  //! @param  nThreads  number of threads, including the calling thread
+  //----------------------------------------------------------------------------//
+  WorkStealingPool::WorkStealingPool(const unsigned int nThreads) :
+    ThreadPool(1),
+    queued_(0),
+    stopping_(false)
+  {
+    assert(1 <= nThreads and "Pool must have at least one thread");
+
+    for (unsigned int t = 0; t < nThreads; t++) queues_.push_back(std::make_unique<Queues>());
+    for (unsigned int t = 1; t < nThreads; t++) threads_.emplace_back(&WorkStealingPool::serve, this, t);
+  }
+
+  //----------------------------------------------------------------------------//
+  //! join threads
+  //----------------------------------------------------------------------------//
+  WorkStealingPool::~WorkStealingPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(sleepMutex_);
+      stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto &thread : threads_) thread.join();
+  }
+
+  //----------------------------------------------------------------------------//
+  //! number of threads, including the calling thread
+  //----------------------------------------------------------------------------//
+  unsigned int WorkStealingPool::size() const {return queues_.size();}
+
+  //----------------------------------------------------------------------------//
+  //! call fn(begin, end, chunk) for each of size() chunks of [0, n)
+  //! the calling thread queues the chunks, runs the first, then runs those
+  //! of its chunks that no other thread stole, newest first, until all are done
+  //! a thread outside the pool counts as the calling thread of the pool,
+  //! and such callers are serialized
+  //----------------------------------------------------------------------------//
+  void WorkStealingPool::parallelFor(const unsigned int n,
+      const std::function<void(unsigned int, unsigned int, unsigned int)> &fn)
+  {
+    std::unique_lock<std::mutex> call(callMutex_, std::defer_lock);
+    if (currentPool != this) call.lock();
+    const unsigned int self = currentPool == this ? currentThread : 0;
+
+    // empty chunks aren't worth queueing
+    std::atomic<unsigned int> pending(0);
+    for (unsigned int c = size(); c-- > 1;) {
+      const unsigned int begin = chunkBegin(n, c),
+                         end = chunkBegin(n, c + 1);
+      if (begin == end) {fn(begin, end, c); continue;}
+      pending++;
+      push(self, {&fn, begin, end, c, &pending}, true);
+    }
+    fn(chunkBegin(n, 0), chunkBegin(n, 1), 0);
+
+    // once its own chunks are taken, only the stolen ones are left to wait for
+    Task task;
+    while (pending) {
+      if (take(self, task, true)) {run(task); continue;}
+      std::unique_lock<std::mutex> lock(sleepMutex_);
+      wake_.wait(lock, [&pending] {return !pending;});
+    }
+  }
+
+  //----------------------------------------------------------------------------//
+  //! call fn(task, thread) for each task, where thread < size() is the
+  //! index of the thread running it
+  //! tasks are dealt out in turn, so each thread starts from the front of
+  //! order, and threads that run out take the others' next tasks
+  //! returns once every task is done, the calling thread taking part
+  //! @param  order  tasks, which should be sorted by decreasing cost
+  //! @param  fn     function called for each task
+  //----------------------------------------------------------------------------//
+  void WorkStealingPool::runTasks(const std::vector<unsigned int> &order,
+      const std::function<void(unsigned int, unsigned int)> &fn)
+  {
+    std::lock_guard<std::mutex> call(callMutex_);
+    const WorkStealingPool *outerPool = currentPool;
+    const unsigned int outerThread = currentThread;
+    currentPool = this;
+    currentThread = 0;
+
+    // tasks get the range [task, task + 1), and the thread as their chunk
+    const std::function<void(unsigned int, unsigned int, unsigned int)> taskFn =
+      [&fn](const unsigned int b, const unsigned int, const unsigned int t) {fn(b, t);};
+    std::atomic<unsigned int> pending(order.size());
+    for (unsigned int k = 0; k < order.size(); k++) {
+      push(k % size(), {&taskFn, order[k], order[k] + 1, 0, &pending}, false);
+    }
+
+    // sleep while other threads run the last tasks, unless they queue chunks
+    Task task;
+    while (pending) {
+      if (take(0, task, false)) {run(task); continue;}
+      std::unique_lock<std::mutex> lock(sleepMutex_);
+      wake_.wait(lock, [this, &pending] {return !pending or queued_;});
+    }
+
+    currentPool = outerPool;
+    currentThread = outerThread;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! queue a task or chunk on a thread and wake the others
+  //! @param  thread  index of thread whose queue gets the work
+  //! @param  task    task or chunk
+  //! @param  chunk   whether task is a chunk of a loop
+  //----------------------------------------------------------------------------//
+  void WorkStealingPool::push(const unsigned int thread,
+      const Task &task,
+      const bool chunk)
+  {
+    {
+      std::lock_guard<std::mutex> lock(queues_[thread]->mutex);
+      (chunk ? queues_[thread]->chunks : queues_[thread]->tasks).push_back(task);
+    }
+    queued_++;
+    {
+      std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    wake_.notify_all();
+  }
+
+  //----------------------------------------------------------------------------//
+  //! take work for a thread, in order of preference: its newest chunk,
+  //! the oldest chunk of another thread, which some loop is waiting for,
+  //! its next task and the next task of another thread
+  //! @param  thread      index of thread
+  //! @param  task        work taken, whose chunk is set to thread if a task
+  //! @param  chunksOnly  whether to only take the thread's own chunks
+  //! returns false if there was no work to take
+  //----------------------------------------------------------------------------//
+  bool WorkStealingPool::take(const unsigned int thread,
+      Task &task,
+      const bool chunksOnly)
+  {
+    if (!queued_) return false;
+    const unsigned int n = size();
+
+    // pop from the back or front of one queue
+    auto pop = [this, &task](const unsigned int t, const bool chunk, const bool back) {
+      Queues &queues = *queues_[t];
+      std::lock_guard<std::mutex> lock(queues.mutex);
+      std::deque<Task> &queue = chunk ? queues.chunks : queues.tasks;
+      if (queue.empty()) return false;
+      task = back ? queue.back() : queue.front();
+      if (back) queue.pop_back();
+      else queue.pop_front();
+      queued_--;
+      return true;
+    };
+
+    if (pop(thread, true, true)) return true;
+    if (chunksOnly) return false;
+    for (unsigned int k = 1; k < n; k++) {
+      if (pop((thread + k) % n, true, false)) return true;
+    }
+    for (unsigned int k = 0; k < n; k++) {
+      if (pop((thread + k) % n, false, false)) {task.chunk = thread; return true;}
+    }
+    return false;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! run work taken by take, and wake the thread waiting for its loop or
+  //! batch if it was the last
+  //----------------------------------------------------------------------------//
+  void WorkStealingPool::run(const Task &task)
+  {
+    (*task.fn)(task.begin, task.end, task.chunk);
+    if (--(*task.pending)) return;
+    {
+      std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    wake_.notify_all();
+  }
+
+  //----------------------------------------------------------------------------//
+  //! loop run by each stealing thread, sleeping while there is no work
+  //! @param  thread  index of this thread
+  //----------------------------------------------------------------------------//
+  void WorkStealingPool::serve(const unsigned int thread)
+  {
+    currentPool = this;
+    currentThread = thread;
+    Task task;
+    while (true) {
+      if (take(thread, task, false)) {run(task); continue;}
+      std::unique_lock<std::mutex> lock(sleepMutex_);
+      wake_.wait(lock, [this] {return stopping_ or queued_;});
+      if (stopping_) return;
+    }
+  }
+
+}
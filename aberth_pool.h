@@ -0,0 +1,210 @@
+/* Persistent pools of worker threads */
+#ifndef _ABERTH_POOL_H_
+#define _ABERTH_POOL_H_
+
+// includes, system
+#include <vector>
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace aberth
+{
+
+  //----------------------------------------------------------------------------//
+  //! Pool of threads that split loops into fixed contiguous chunks
+  //! chunk boundaries depend only on the loop length and the pool size,
+  //! so work is always assigned the same way
+  //! parallelFor may be called from within a chunk, whose thread then runs
+  //! every chunk of the inner loop itself
+  //----------------------------------------------------------------------------//
+  class ThreadPool
+  {
+
+    //**************************************//
+    // data members
+    //**************************************//
+
+    protected:
+
+      //! worker threads (the calling thread runs the first chunk)
+      std::vector<std::thread> workers_;
+
+      //! serializes concurrent callers of parallelFor
+      std::mutex callMutex_;
+
+      //! guards the state below
+      std::mutex mutex_;
+
+      //! signals workers that a job is ready or the pool is stopping
+      std::condition_variable start_;
+
+      //! signals the caller that all chunks are done
+      std::condition_variable done_;
+
+      //! current job
+      const std::function<void(unsigned int, unsigned int, unsigned int)> *job_;
+
+      //! length of current loop
+      unsigned int n_;
+
+      //! incremented for every job
+      unsigned long generation_;
+
+      //! number of workers yet to finish current job
+      unsigned int pending_;
+
+      //! whether or not workers should exit
+      bool stop_;
+
+    //**************************************//
+    // member functions
+    //**************************************//
+
+    public:
+
+      //! non-default constructor
+      explicit ThreadPool(const unsigned int nThreads);
+
+      //! join workers
+      virtual ~ThreadPool();
+
+      //! not copyable
+      ThreadPool(const ThreadPool &other) = delete;
+      ThreadPool& operator=(const ThreadPool &other) = delete;
+
+      //! number of threads, including the calling thread
+      virtual unsigned int size() const;
+
+      //! call fn(begin, end, chunk) for each of size() chunks of [0, n)
+      virtual void parallelFor(const unsigned int n,
+          const std::function<void(unsigned int, unsigned int, unsigned int)> &fn);
+
+      //! first index of chunk c of [0, n)
+      unsigned int chunkBegin(const unsigned int n, const unsigned int c) const;
+
+    protected:
+
+      //! loop run by each worker
+      void work(const unsigned int chunk);
+
+  };
+
+  //----------------------------------------------------------------------------//
+  //! Pool of threads that each keep their own queues and steal from others
+  //! runTasks deals tasks out in a given order, and threads that run out
+  //! take tasks from the others' queues, so long tasks don't leave threads idle
+  //! parallelFor may be called from within a task: its chunks are queued by
+  //! the calling thread, which runs them itself unless other threads steal
+  //! them first, so a task can spread over threads that are free
+  //! chunks are the same as those of ThreadPool, so a ZeroFinder iterates
+  //! the same way with either pool
+  //----------------------------------------------------------------------------//
+  class WorkStealingPool : public ThreadPool
+  {
+
+    //**************************************//
+    // data members
+    //**************************************//
+
+    protected:
+
+      //! a chunk of a loop, or a task of runTasks
+      struct Task
+      {
+
+        //! function called with begin, end and chunk (or thread for tasks)
+        const std::function<void(unsigned int, unsigned int, unsigned int)> *fn;
+
+        //! range and chunk index passed to fn
+        unsigned int begin,
+                     end,
+                     chunk;
+
+        //! decremented once fn returns
+        std::atomic<unsigned int> *pending;
+      };
+
+      //! queues of one thread, each guarded by mutex
+      struct Queues
+      {
+
+        //! guards the queues
+        std::mutex mutex;
+
+        //! chunks of loops started by this thread, newest last
+        std::deque<Task> chunks;
+
+        //! tasks dealt to this thread, costliest first
+        std::deque<Task> tasks;
+      };
+
+      //! queues of each thread (the calling thread has the first)
+      std::vector<std::unique_ptr<Queues>> queues_;
+
+      //! stealing threads, besides the calling thread
+      std::vector<std::thread> threads_;
+
+      //! number of tasks and chunks in all queues
+      std::atomic<unsigned long> queued_;
+
+      //! guards stopping_ for threads waiting for work, or for the rest of
+      //! their loop or batch
+      std::mutex sleepMutex_;
+
+      //! signals threads that work was queued, a loop or batch is done, or
+      //! the pool is stopping
+      std::condition_variable wake_;
+
+      //! whether or not threads should exit
+      bool stopping_;
+
+    //**************************************//
+    // member functions
+    //**************************************//
+
+    public:
+
+      //! non-default constructor
+      explicit WorkStealingPool(const unsigned int nThreads);
+
+      //! join threads
+      ~WorkStealingPool();
+
+      //! number of threads, including the calling thread
+      unsigned int size() const override;
+
+      //! call fn(begin, end, chunk) for each of size() chunks of [0, n)
+      void parallelFor(const unsigned int n,
+          const std::function<void(unsigned int, unsigned int, unsigned int)> &fn) override;
+
+      //! call fn(task, thread) for each task, dealt out in the given order
+      void runTasks(const std::vector<unsigned int> &order,
+          const std::function<void(unsigned int, unsigned int)> &fn);
+
+    protected:
+
+      //! queue a task or chunk on a thread and wake the others
+      void push(const unsigned int thread,
+          const Task &task,
+          const bool chunk);
+
+      //! take work for a thread, only its own chunks if chunksOnly
+      bool take(const unsigned int thread,
+          Task &task,
+          const bool chunksOnly);
+
+      //! run work taken by take, waking its waiting thread if the last
+      void run(const Task &task);
+
+      //! loop run by each stealing thread
+      void serve(const unsigned int thread);
+
+  };
+}
+
+#endif  // #ifndef _ABERTH_POOL_H_
@@ -0,0 +1,107 @@
+/* Counter-based random numbers for initial guesses */
+#ifndef _ABERTH_RNG_H_
+#define _ABERTH_RNG_H_
+
+// includes, system
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+
+namespace aberth
+{
+
+  //----------------------------------------------------------------------------//
+  //! Counter-based generator after SplitMix64
+  //! the kth draw is a hash of seed + (k + 1) GAMMA, with no state carried from
+  //! one draw to the next, so a range of draws is filled in one loop the
+  //! compiler may vectorize, and each solver owns its stream, where std::rand
+  //! shares one behind a lock
+  //----------------------------------------------------------------------------//
+  class SplitMix
+  {
+
+    //**************************************//
+    // data members
+    //**************************************//
+
+    public:
+
+      //! seed of solvers that aren't given one
+      static constexpr uint64_t DEFAULT_SEED = 8008335;
+
+      //! odd increment of the counter, 2^64 over the golden ratio
+      static constexpr uint64_t GAMMA = 0x9e3779b97f4a7c15;
+
+    protected:
+
+      //! seed of stream
+      uint64_t seed_;
+
+      //! number of draws so far
+      uint64_t counter_;
+
+    //**************************************//
+    // member functions
+    //**************************************//
+
+    public:
+
+      //! non-default constructor
+      explicit SplitMix(const uint64_t seed = DEFAULT_SEED) :
+        seed_(seed),
+        counter_(0)
+      {}
+
+      //! start the stream of seed over
+      void seed(const uint64_t seed) {seed_ = seed; counter_ = 0;}
+
+      //! return seed of stream
+      uint64_t getSeed() const {return seed_;}
+
+      //! finalizer of SplitMix64, a bijection mixing every bit into every other
+      static uint64_t mix(uint64_t z)
+      {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+      }
+
+      //! return kth draw of stream, also a seed for the kth of independent
+      //! streams derived from this one
+      uint64_t at(const uint64_t k) const {return mix(seed_ + (k + 1) * GAMMA);}
+
+      //! return next draw
+      uint64_t next() {return at(counter_++);}
+
+      //! x converted exactly to T, in halves for class types that only
+      //! convert from double
+      template <typename T>
+      static T toReal(const uint64_t x)
+      {
+        if constexpr (std::is_arithmetic<T>::value) return static_cast<T>(x);
+        else {
+          return static_cast<T>(static_cast<double>(x >> 32)) * 4294967296. +
+            static_cast<T>(static_cast<double>(x & 0xffffffff));
+        }
+      }
+
+      //! fill out[0, n) with the next n draws as uniform numbers in [0, 1),
+      //! keeping the leading bits that fit in the mantissa of T
+      template <typename T>
+      void fill(T *out, const unsigned int n)
+      {
+        constexpr int bits = std::min(std::numeric_limits<T>::digits, 64);
+        const T ulp = static_cast<T>(1) /
+          (static_cast<T>(uint64_t(1) << (bits - 1)) * static_cast<T>(2));
+        const uint64_t base = seed_ + counter_ * GAMMA;
+        for(unsigned int i = 0; i < n; i++) {
+          out[i] = toReal<T>(mix(base + (i + 1) * GAMMA) >> (64 - bits)) * ulp;
+        }
+        counter_ += n;
+      }
+
+  };
+}
+
+#endif  // #ifndef _ABERTH_RNG_H_
@@ -0,0 +1,211 @@
+// includes, system
+#include <cassert>
+#include <cstring>
+#include <type_traits>
+
+// includes, project
+#include "aberth_simd.h"
+#include "aberth_dd.h"
+
+namespace aberth
+{
+  namespace simd
+  {
+
+    //----------------------------------------------------------------------------//
+    //! vector types of 16, 32 and 64 bytes
+    //----------------------------------------------------------------------------//
+    typedef double double2 __attribute__((vector_size(16)));
+    typedef double double4 __attribute__((vector_size(32)));
+    typedef double double8 __attribute__((vector_size(64)));
+    typedef float float4 __attribute__((vector_size(16)));
+    typedef float float8 __attribute__((vector_size(32)));
+    typedef float float16 __attribute__((vector_size(64)));
+
+    //----------------------------------------------------------------------------//
+    //! add 1 / d = conj(d) / |d|^2 to (sRe, sIm)
+    //----------------------------------------------------------------------------//
+    template <typename T>
+    static inline __attribute__((always_inline))
+    void addRecip(const T dRe, const T dIm, T &sRe, T &sIm)
+    {
+      const T inv = static_cast<T>(1) / (dRe * dRe + dIm * dIm);
+      sRe += dRe * inv;
+      sIm -= dIm * inv;
+    }
+
+    //----------------------------------------------------------------------------//
+    //! generic row kernel over vectors of type V holding W elts of type T
+    //! inlined into the wrappers below, which set the instruction set
+    //! lanes are reduced in a fixed order, then the scalar tail is added
+    //----------------------------------------------------------------------------//
+    template <typename V, typename T>
+    static inline __attribute__((always_inline))
+    void rowKernel(const T *re, const T *im, const unsigned int n,
+        const unsigned int i, T &sRe, T &sIm)
+    {
+      constexpr unsigned int W = sizeof(V) / sizeof(T);
+
+      // broadcast ith zero, zero accumulators
+      V zRe, zIm, accRe, accIm, one;
+      for (unsigned int l = 0; l < W; l++) {
+        zRe[l] = re[i]; zIm[l] = im[i];
+        accRe[l] = 0; accIm[l] = 0;
+        one[l] = 1;
+      }
+
+      // scalar remainders of the two ranges [0, i) and (i, n)
+      T tailRe = 0,
+        tailIm = 0;
+
+      for (unsigned int r = 0; r < 2; r++) {
+        unsigned int j = r ? i + 1 : 0;
+        const unsigned int end = r ? n : i;
+        for (; j + W <= end; j += W) {
+          V wRe, wIm;
+          memcpy(&wRe, re + j, sizeof(V));
+          memcpy(&wIm, im + j, sizeof(V));
+          const V dRe = zRe - wRe,
+                  dIm = zIm - wIm,
+                  inv = one / (dRe * dRe + dIm * dIm);
+          accRe += dRe * inv;
+          accIm -= dIm * inv;
+        }
+        for (; j < end; j++) addRecip(re[i] - re[j], im[i] - im[j], tailRe, tailIm);
+      }
+
+      sRe = 0;
+      sIm = 0;
+      for (unsigned int l = 0; l < W; l++) {sRe += accRe[l]; sIm += accIm[l];}
+      sRe += tailRe;
+      sIm += tailIm;
+    }
+
+    //----------------------------------------------------------------------------//
+    //! scalar fallback
+    //----------------------------------------------------------------------------//
+    template <typename T>
+    static void rowScalar(const T *re, const T *im, const unsigned int n,
+        const unsigned int i, T &sRe, T &sIm)
+    {
+      sRe = 0;
+      sIm = 0;
+      for (unsigned int j = 0; j < n; j++) {
+        if (j != i) addRecip(re[i] - re[j], im[i] - im[j], sRe, sIm);
+      }
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+
+    //----------------------------------------------------------------------------//
+    //! instruction set specific wrappers
+    //----------------------------------------------------------------------------//
+    __attribute__((target("sse2")))
+    static void rowSse(const double *re, const double *im, const unsigned int n,
+        const unsigned int i, double &sRe, double &sIm)
+    {rowKernel<double2>(re, im, n, i, sRe, sIm);}
+
+    __attribute__((target("sse2")))
+    static void rowSse(const float *re, const float *im, const unsigned int n,
+        const unsigned int i, float &sRe, float &sIm)
+    {rowKernel<float4>(re, im, n, i, sRe, sIm);}
+
+    __attribute__((target("avx2")))
+    static void rowAvx2(const double *re, const double *im, const unsigned int n,
+        const unsigned int i, double &sRe, double &sIm)
+    {rowKernel<double4>(re, im, n, i, sRe, sIm);}
+
+    __attribute__((target("avx2")))
+    static void rowAvx2(const float *re, const float *im, const unsigned int n,
+        const unsigned int i, float &sRe, float &sIm)
+    {rowKernel<float8>(re, im, n, i, sRe, sIm);}
+
+    __attribute__((target("avx512f")))
+    static void rowAvx512(const double *re, const double *im, const unsigned int n,
+        const unsigned int i, double &sRe, double &sIm)
+    {rowKernel<double8>(re, im, n, i, sRe, sIm);}
+
+    __attribute__((target("avx512f")))
+    static void rowAvx512(const float *re, const float *im, const unsigned int n,
+        const unsigned int i, float &sRe, float &sIm)
+    {rowKernel<float16>(re, im, n, i, sRe, sIm);}
+
+#endif
+
+    //----------------------------------------------------------------------------//
+    //! best instruction set level supported by this cpu
+    //----------------------------------------------------------------------------//
+    Isa detectIsa()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx512f")) return Isa::avx512;
+      if (__builtin_cpu_supports("avx2")) return Isa::avx2;
+      if (__builtin_cpu_supports("sse2")) return Isa::sse;
+#endif
+      return Isa::scalar;
+    }
+
+    //----------------------------------------------------------------------------//
+    //! name of an instruction set level
+    //----------------------------------------------------------------------------//
+    const char *isaName(const Isa isa)
+    {
+      switch (isa) {
+        case Isa::sse: return "sse";
+        case Isa::avx2: return "avx2";
+        case Isa::avx512: return "avx512";
+        default: return "scalar";
+      }
+    }
+
+    //----------------------------------------------------------------------------//
+    //! sum of 1 / (z_i - z_j) over j != i for zeros given as split arrays
+    //----------------------------------------------------------------------------//
+    template <typename T>
+    void invDiffSumRow(const T *re,
+        const T *im,
+        const unsigned int n,
+        const unsigned int i,
+        T &sRe,
+        T &sIm,
+        const Isa isa)
+    {
+      assert(i < n and "Row must be within range");
+
+      // no vector kernels for extended precision
+      if constexpr (not std::is_same<T, float>::value and
+                    not std::is_same<T, double>::value) {
+        rowScalar(re, im, n, i, sRe, sIm);
+      }
+      else {
+        switch (isa) {
+#if defined(__x86_64__) || defined(__i386__)
+          case Isa::sse: rowSse(re, im, n, i, sRe, sIm); break;
+          case Isa::avx2: rowAvx2(re, im, n, i, sRe, sIm); break;
+          case Isa::avx512: rowAvx512(re, im, n, i, sRe, sIm); break;
+#endif
+          default: rowScalar(re, im, n, i, sRe, sIm); break;
+        }
+      }
+    }
+
+    //----------------------------------------------------------------------------//
+    // specialization
+    //----------------------------------------------------------------------------//
+    template void invDiffSumRow<float>(const float *, const float *,
+        const unsigned int, const unsigned int, float &, float &, const Isa);
+    template void invDiffSumRow<double>(const double *, const double *,
+        const unsigned int, const unsigned int, double &, double &, const Isa);
+    template void invDiffSumRow<long double>(const long double *,
+        const long double *, const unsigned int, const unsigned int,
+        long double &, long double &, const Isa);
+    template void invDiffSumRow<DoubleDouble>(const DoubleDouble *,
+        const DoubleDouble *, const unsigned int, const unsigned int,
+        DoubleDouble &, DoubleDouble &, const Isa);
+    template void invDiffSumRow<QuadDouble>(const QuadDouble *,
+        const QuadDouble *, const unsigned int, const unsigned int,
+        QuadDouble &, QuadDouble &, const Isa);
+
+  }
+}
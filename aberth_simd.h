@@ -0,0 +1,48 @@
+/* Vectorized kernels with runtime dispatch */
+#ifndef _ABERTH_SIMD_H_
+#define _ABERTH_SIMD_H_
+
+namespace aberth
+{
+  namespace simd
+  {
+
+    //----------------------------------------------------------------------------//
+    //! instruction set levels, in increasing order
+    //----------------------------------------------------------------------------//
+    enum class Isa {scalar, sse, avx2, avx512};
+
+    //----------------------------------------------------------------------------//
+    //! best instruction set level supported by this cpu
+    //----------------------------------------------------------------------------//
+    Isa detectIsa();
+
+    //----------------------------------------------------------------------------//
+    //! name of an instruction set level
+    //----------------------------------------------------------------------------//
+    const char *isaName(const Isa isa);
+
+    //----------------------------------------------------------------------------//
+    //! sum of 1 / (z_i - z_j) over j != i for zeros given as split arrays
+    //! results are reproducible bit for bit for a given isa
+    //! @param  re   real parts of zeros
+    //! @param  im   imag parts of zeros
+    //! @param  n    number of zeros
+    //! @param  i    index of zero for which the sum is computed
+    //! @param  sRe  real part of sum
+    //! @param  sIm  imag part of sum
+    //! @param  isa  instruction set level to use
+    //----------------------------------------------------------------------------//
+    template <typename T>
+    void invDiffSumRow(const T *re,
+        const T *im,
+        const unsigned int n,
+        const unsigned int i,
+        T &sRe,
+        T &sIm,
+        const Isa isa);
+
+  }
+}
+
+#endif  // #ifndef _ABERTH_SIMD_H_
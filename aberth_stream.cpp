@@ -0,0 +1,389 @@
+// includes, system
+#include <vector>
+#include <string>
+#include <complex>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cctype>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// includes, project
+#include "aberth.h"
+#include "aberth_stream.h"
+
+namespace aberth
+{
+
+  //----------------------------------------------------------------------------//
+  //! non-default constructor
+  //! settings of the ZeroFinder<double> used for every polynomial
+  //! initMode defaults to "newton", and "rand" and "symm" guesses are drawn
+  //! from a stream seeded by the polynomial's position in the input, so
+  //! results don't depend on which worker solves which polynomial
+  //----------------------------------------------------------------------------//
+  StreamSolver::StreamSolver(const double tol,
+      const unsigned int maxIters,
+      const std::string initMode) :
+    tol_(tol),
+    maxIters_(maxIters),
+    initMode_(initMode),
+    nThreads_(0),
+    batchSize_(256),
+    queueDepth_(4),
+    nPolys_(0),
+    nConv_(0),
+    nInvalid_(0)
+  {
+
+    // tolerance must be above smallest positive double
+    assert(DBL_MIN <= tol and "tol must be at least DBL_MIN");
+
+    // only three methods of initializing zeros
+    assert((initMode == "rand" or initMode == "symm" or initMode == "newton") and
+        "initMode must be either 'rand', 'symm' or 'newton'");
+  }
+
+  //----------------------------------------------------------------------------//
+  //! solve with nThreads worker threads, besides the reader and the writer
+  //! (one per core if 0)
+  //----------------------------------------------------------------------------//
+  void StreamSolver::setNumThreads(const unsigned int nThreads) {nThreads_ = nThreads;}
+
+  //----------------------------------------------------------------------------//
+  //! cut input into batches of batchSize records
+  //! larger batches take the queues' locks less often
+  //----------------------------------------------------------------------------//
+  void StreamSolver::setBatchSize(const unsigned int batchSize)
+  {
+    assert(1 <= batchSize and "Batches must hold at least one record");
+    batchSize_ = batchSize;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! let up to queueDepth batches wait to be solved, and as many to be written
+  //----------------------------------------------------------------------------//
+  void StreamSolver::setQueueDepth(const unsigned int queueDepth)
+  {
+    assert(1 <= queueDepth and "Queues must hold at least one batch");
+    queueDepth_ = queueDepth;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! seed the streams that "rand" and "symm" guesses are drawn from, the kth
+  //! polynomial in the input being seeded with the kth draw of seed's stream
+  //----------------------------------------------------------------------------//
+  void StreamSolver::setSeed(const uint64_t seed)
+  {
+    rng_.seed(seed);
+  }
+
+  //----------------------------------------------------------------------------//
+  //! solve every polynomial in the file inPath, writing results to outPath
+  //! in the format of the input (binary or text, see class comment)
+  //! batches are passed by index between the free, work and done queues, so
+  //! once they have grown to the largest batch nothing is allocated
+  //! @param  inPath   input file
+  //! @param  outPath  output file, which is overwritten
+  //! returns false, with a message in getError, if either file fails or
+  //! the input is malformed
+  //----------------------------------------------------------------------------//
+  bool StreamSolver::run(const std::string &inPath, const std::string &outPath)
+  {
+    error_.clear();
+    nPolys_ = 0;
+    nConv_ = 0;
+    nInvalid_ = 0;
+
+    //**************************************//
+    // map input and open output
+    //**************************************//
+
+    const int fd = open(inPath.c_str(), O_RDONLY);
+    if (fd < 0) {error_ = "cannot open " + inPath; return false;}
+    struct stat st;
+    if (fstat(fd, &st)) {close(fd); error_ = "cannot stat " + inPath; return false;}
+    const size_t size = st.st_size;
+    const char *data = nullptr;
+    if (size) {
+      void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (map == MAP_FAILED) {close(fd); error_ = "cannot map " + inPath; return false;}
+      madvise(map, size, MADV_SEQUENTIAL);
+      data = static_cast<const char *>(map);
+    }
+    close(fd);
+    const char *end = data + size;
+
+    const bool binary = 8 <= size and !memcmp(data, INPUT_MAGIC, 8);
+    FILE *out = fopen(outPath.c_str(), "wb");
+    if (!out) {
+      if (size) munmap(const_cast<char *>(data), size);
+      error_ = "cannot open " + outPath;
+      return false;
+    }
+    bool writeFailed = binary and fwrite(OUTPUT_MAGIC, 1, 8, out) != 8;
+
+    //**************************************//
+    // reader and workers
+    //**************************************//
+
+    // batches being solved, waiting to be solved and waiting to be written
+    const unsigned int nThreads = nThreads_ ? nThreads_ :
+      std::max(1u, std::thread::hardware_concurrency()),
+                       nBatches = nThreads + 2 * queueDepth_;
+    std::vector<Batch> batches(nBatches);
+    BoundedQueue<unsigned int> freeQueue(nBatches),
+                               workQueue(queueDepth_),
+                               doneQueue(nBatches);
+    for (unsigned int b = 0; b < nBatches; b++) freeQueue.push(b);
+
+    // the writer stops the reader if output fails
+    std::atomic<bool> stop(false);
+    bool malformed = false;
+    std::thread reader([&]() {
+      const char *pos = data + (binary ? 8 : 0);
+      unsigned long seq = 0;
+      unsigned int b;
+      while (pos < end and !malformed and !stop and freeQueue.pop(b)) {
+        batches[b].seq = seq++;
+        malformed = !readBatch(pos, end, binary, batches[b]);
+        workQueue.push(b);
+      }
+      workQueue.close();
+    });
+
+    // the last worker to finish lets the writer know
+    std::atomic<unsigned int> running(nThreads);
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < nThreads; t++) {
+      workers.emplace_back([&]() {
+        std::unique_ptr<ZeroFinder<double>> finder;
+        std::vector<std::complex<double>> coeffs;
+        std::string line;
+        unsigned int b;
+        while (workQueue.pop(b)) {
+          solveBatch(batches[b], binary, finder, coeffs, line);
+          doneQueue.push(b);
+        }
+        if (!--running) doneQueue.close();
+      });
+    }
+
+    //**************************************//
+    // writer
+    //**************************************//
+
+    // batches are written in input order, then the pages of input before
+    // them are dropped
+    const size_t page = sysconf(_SC_PAGESIZE);
+    const char *released = data;
+    std::vector<unsigned int> waiting;
+    waiting.reserve(nBatches);
+    unsigned long next = 0;
+    unsigned int b;
+    while (doneQueue.pop(b)) {
+      waiting.push_back(b);
+      for (auto it = waiting.begin(); it != waiting.end();) {
+        Batch &batch = batches[*it];
+        if (batch.seq != next) {it++; continue;}
+        if (!writeFailed and fwrite(batch.out.data(), 1, batch.out.size(), out) !=
+            batch.out.size()) {writeFailed = true; stop = true;}
+        if (!batch.records.empty()) {
+          nPolys_ += batch.records.size() - 1;
+          const char *upto = data + (batch.records.back() - data) / page * page;
+          if (released < upto) {
+            madvise(const_cast<char *>(released), upto - released, MADV_DONTNEED);
+            released = upto;
+          }
+        }
+        nConv_ += batch.conv;
+        nInvalid_ += batch.invalid;
+        freeQueue.push(*it);
+        waiting.erase(it);
+        it = waiting.begin();
+        next++;
+      }
+    }
+
+    reader.join();
+    for (auto &worker : workers) worker.join();
+    if (fclose(out)) writeFailed = true;
+    if (size) munmap(const_cast<char *>(data), size);
+
+    if (writeFailed) error_ = "cannot write " + outPath;
+    else if (malformed) error_ = "malformed record after polynomial " +
+      std::to_string(nPolys_) + " of " + inPath;
+    return error_.empty();
+  }
+
+  //----------------------------------------------------------------------------//
+  //! description of the last failure
+  //----------------------------------------------------------------------------//
+  const std::string& StreamSolver::getError() const {return error_;}
+
+  //----------------------------------------------------------------------------//
+  //! number of polynomials in the input of the last run
+  //----------------------------------------------------------------------------//
+  unsigned long StreamSolver::getNumPolys() const {return nPolys_;}
+
+  //----------------------------------------------------------------------------//
+  //! number of polynomials whose zeros all converged in the last run
+  //----------------------------------------------------------------------------//
+  unsigned long StreamSolver::getNumConv() const {return nConv_;}
+
+  //----------------------------------------------------------------------------//
+  //! number of invalid records in the last run
+  //----------------------------------------------------------------------------//
+  unsigned long StreamSolver::getNumInvalid() const {return nInvalid_;}
+
+  //----------------------------------------------------------------------------//
+  //! cut up to batchSize_ records from the input at pos, which is advanced
+  //! past them (and past blank and comment lines of text input)
+  //! only record boundaries are found here, parsing is left to the workers
+  //! @param  pos     start of remaining input
+  //! @param  end     end of input
+  //! @param  binary  whether or not input is binary
+  //! @param  batch   batch whose records are set
+  //! returns false if a binary record runs past the end of input
+  //----------------------------------------------------------------------------//
+  bool StreamSolver::readBatch(const char *&pos,
+      const char *end,
+      const bool binary,
+      Batch &batch) const
+  {
+    batch.records.clear();
+    bool ok = true;
+    while (batch.records.size() < batchSize_ and pos < end) {
+      if (binary) {
+        uint32_t n;
+        if (end - pos < 4) {ok = false; break;}
+        memcpy(&n, pos, 4);
+        if (static_cast<size_t>(end - pos - 4) / 16 < n) {ok = false; break;}
+        batch.records.push_back(pos);
+        pos += 4 + 16 * static_cast<size_t>(n);
+      }
+      else {
+        const char *eol = static_cast<const char *>(memchr(pos, '\n', end - pos)),
+                   *first = pos;
+        const char *next = eol ? eol + 1 : end;
+        while (first < next and isspace(static_cast<unsigned char>(*first))) first++;
+        if (first < next and *first != '#') batch.records.push_back(pos);
+        pos = next;
+      }
+    }
+    if (!batch.records.empty()) batch.records.push_back(pos);
+    return ok;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! solve the records of a batch and format their results
+  //! leading zero coeffs are dropped, and records that are then not
+  //! polynomials of degree at least 1 with finite coeffs are invalid
+  //! @param  batch   batch whose records are solved
+  //! @param  binary  whether or not input and output are binary
+  //! @param  finder  finder of this worker, created by the first record and
+  //!                 reset for later ones so that its buffers are reused
+  //! @param  coeffs  scratch space for coeffs
+  //! @param  line    scratch space for a line of text input
+  //----------------------------------------------------------------------------//
+  void StreamSolver::solveBatch(Batch &batch,
+      const bool binary,
+      std::unique_ptr<ZeroFinder<double>> &finder,
+      std::vector<std::complex<double>> &coeffs,
+      std::string &line) const
+  {
+    batch.out.clear();
+    batch.conv = 0;
+    batch.invalid = 0;
+    char buf[64];
+    for (unsigned int r = 0; r + 1 < batch.records.size(); r++) {
+
+      // parse coeffs
+      coeffs.clear();
+      bool valid = true;
+      if (binary) {
+        uint32_t n;
+        memcpy(&n, batch.records[r], 4);
+        const char *pos = batch.records[r] + 4;
+        for (uint32_t k = 0; k < n; k++, pos += 16) {
+          double re, im;
+          memcpy(&re, pos, 8);
+          memcpy(&im, pos + 8, 8);
+          coeffs.emplace_back(re, im);
+        }
+      }
+      else {
+        // blank and comment lines may follow the record's own line
+        const char *eol = static_cast<const char *>(memchr(batch.records[r], '\n',
+              batch.records[r + 1] - batch.records[r]));
+        line.assign(batch.records[r], eol ? eol : batch.records[r + 1]);
+        const char *pos = line.c_str();
+        char *next;
+        while (true) {
+          const double re = strtod(pos, &next);
+          if (next == pos) break;
+          pos = next;
+          const double im = strtod(pos, &next);
+          if (next == pos) {valid = false; break;}
+          pos = next;
+          coeffs.emplace_back(re, im);
+        }
+        while (isspace(static_cast<unsigned char>(*pos))) pos++;
+        if (*pos) valid = false;
+      }
+      while (!coeffs.empty() and coeffs.back() == std::complex<double>(0)) coeffs.pop_back();
+      for (const auto &coeffsI : coeffs) {
+        if (!std::isfinite(coeffsI.real()) or !std::isfinite(coeffsI.imag())) valid = false;
+      }
+      valid = valid and 2 <= coeffs.size();
+
+      // solve
+      int32_t status = -1;
+      uint32_t iters = 0,
+               nZeros = 0;
+      if (valid) {
+        const uint64_t seed = rng_.at(batch.seq * batchSize_ + r);
+        if (finder) finder->reset(coeffs.data(), coeffs.size(), seed);
+        else {
+          finder = std::make_unique<ZeroFinder<double>>(coeffs, tol_, maxIters_, initMode_);
+          finder->setSeed(seed);
+        }
+        status = finder->compZeros();
+        iters = finder->getIters();
+        nZeros = coeffs.size() - 1;
+        batch.conv += status;
+      }
+      else batch.invalid++;
+
+      // format results
+      if (binary) {
+        batch.out.append(reinterpret_cast<const char *>(&status), 4);
+        batch.out.append(reinterpret_cast<const char *>(&iters), 4);
+        batch.out.append(reinterpret_cast<const char *>(&nZeros), 4);
+        if (nZeros) batch.out.append(reinterpret_cast<const char *>(finder->getZeros().data()),
+            16 * static_cast<size_t>(nZeros));
+      }
+      else {
+        batch.out.append(buf, snprintf(buf, sizeof(buf), "%d %u", status, iters));
+        for (uint32_t k = 0; k < nZeros; k++) {
+          const std::complex<double> zero = finder->getZeros()[k];
+          batch.out.append(buf, snprintf(buf, sizeof(buf), " %.17g %.17g",
+                zero.real(), zero.imag()));
+        }
+        batch.out.push_back('\n');
+      }
+    }
+  }
+
+}
@@ -0,0 +1,242 @@
+/* Pipeline solving a file of polynomials into a file of zeros */
+#ifndef _ABERTH_STREAM_H_
+#define _ABERTH_STREAM_H_
+
+// includes, system
+#include <vector>
+#include <string>
+#include <complex>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+// includes, project
+#include "aberth.h"
+
+namespace aberth
+{
+
+  //----------------------------------------------------------------------------//
+  //! Queue of fixed capacity shared by threads
+  //! push blocks while the queue is full and pop while it is empty,
+  //! until the queue is closed
+  //----------------------------------------------------------------------------//
+  template <typename T>
+  class BoundedQueue
+  {
+
+    //**************************************//
+    // data members
+    //**************************************//
+
+    protected:
+
+      //! ring buffer of entries
+      std::vector<T> ring_;
+
+      //! index of first entry and number of entries
+      unsigned int head_,
+                   size_;
+
+      //! whether or not pop should stop waiting once the queue is empty
+      bool closed_;
+
+      //! guards the state above
+      std::mutex mutex_;
+
+      //! signal that an entry was pushed or popped, or the queue was closed
+      std::condition_variable notEmpty_,
+                              notFull_;
+
+    //**************************************//
+    // member functions
+    //**************************************//
+
+    public:
+
+      //! non-default constructor
+      explicit BoundedQueue(const unsigned int capacity) :
+        ring_(capacity),
+        head_(0),
+        size_(0),
+        closed_(false) {}
+
+      //! append entry, waiting for room
+      void push(const T &entry)
+      {
+        {
+          std::unique_lock<std::mutex> lock(mutex_);
+          notFull_.wait(lock, [this] {return size_ < ring_.size();});
+          ring_[(head_ + size_++) % ring_.size()] = entry;
+        }
+        notEmpty_.notify_one();
+      }
+
+      //! remove first entry, waiting for one
+      //! returns false if the queue is closed and empty
+      bool pop(T &entry)
+      {
+        {
+          std::unique_lock<std::mutex> lock(mutex_);
+          notEmpty_.wait(lock, [this] {return size_ or closed_;});
+          if (!size_) return false;
+          entry = ring_[head_];
+          head_ = (head_ + 1) % ring_.size();
+          size_--;
+        }
+        notFull_.notify_one();
+        return true;
+      }
+
+      //! wake threads waiting in pop once the queue is empty
+      void close()
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          closed_ = true;
+        }
+        notEmpty_.notify_all();
+      }
+
+  };
+
+  //----------------------------------------------------------------------------//
+  //! Solve every polynomial of a file and write their zeros to another file
+  //! a reader thread cuts the input into batches of records, worker threads
+  //! solve them, each with its own ZeroFinder<double>, and the calling thread
+  //! writes their results in input order
+  //! a fixed set of batches circulates between the three, so memory stays
+  //! bounded however large the input, which is memory-mapped and whose
+  //! pages are dropped once written
+  //!
+  //! binary input starts with the 8 bytes "ABERTHP1", then for each
+  //! polynomial a uint32 number of coeffs and their real and imag parts as
+  //! doubles, from constant to leading, and binary output starts with
+  //! "ABERTHZ1", then for each polynomial an int32 status, a uint32 number
+  //! of iterations, a uint32 number of zeros and their real and imag parts
+  //! text input has one polynomial per line, as real and imag parts of
+  //! coeffs separated by spaces, and text output one line per polynomial
+  //! with status, iterations and real and imag parts of zeros
+  //! status is 1 if all zeros converged, 0 if not, and -1 if the record is
+  //! not a polynomial of degree at least 1 with finite coeffs
+  //----------------------------------------------------------------------------//
+  class StreamSolver
+  {
+
+    //**************************************//
+    // data members
+    //**************************************//
+
+    public:
+
+      //! leading bytes of binary input and output
+      static constexpr const char *INPUT_MAGIC = "ABERTHP1",
+                                  *OUTPUT_MAGIC = "ABERTHZ1";
+
+    protected:
+
+      //! records of input and results of one batch
+      struct Batch
+      {
+
+        //! position of batch in input
+        unsigned long seq;
+
+        //! start of each record, then end of the last one
+        std::vector<const char *> records;
+
+        //! formatted results
+        std::string out;
+
+        //! number of records whose zeros all converged, and of invalid ones
+        unsigned long conv,
+                      invalid;
+      };
+
+      //! tolerance for calculation
+      double tol_;
+
+      //! maximum number of iterations
+      unsigned int maxIters_;
+
+      //! method for initializing zeros
+      std::string initMode_;
+
+      //! number of worker threads
+      unsigned int nThreads_;
+
+      //! number of records per batch
+      unsigned int batchSize_;
+
+      //! number of batches that may wait in each queue
+      unsigned int queueDepth_;
+
+      //! stream whose kth draw seeds the guesses of the kth polynomial
+      SplitMix rng_;
+
+      //! description of the last failure
+      std::string error_;
+
+      //! number of polynomials solved, converged and invalid in the last run
+      unsigned long nPolys_,
+                    nConv_,
+                    nInvalid_;
+
+    //**************************************//
+    // member functions
+    //**************************************//
+
+    public:
+
+      //! non-default constructor
+      StreamSolver(const double tol = 1e-9,
+          const unsigned int maxIters = 200,
+          const std::string initMode = "newton");
+
+      //! solve with nThreads worker threads (one per core if 0)
+      void setNumThreads(const unsigned int nThreads);
+
+      //! cut input into batches of batchSize records
+      void setBatchSize(const unsigned int batchSize);
+
+      //! let up to queueDepth batches wait between stages
+      void setQueueDepth(const unsigned int queueDepth);
+
+      //! draw guesses of every polynomial from streams derived from seed
+      void setSeed(const uint64_t seed);
+
+      //! solve every polynomial in the file inPath, writing results to outPath
+      //! returns false, with a message in getError, if either file fails
+      bool run(const std::string &inPath, const std::string &outPath);
+
+      //! description of the last failure
+      const std::string& getError() const;
+
+      //! number of polynomials in the input of the last run
+      unsigned long getNumPolys() const;
+
+      //! number of polynomials whose zeros all converged in the last run
+      unsigned long getNumConv() const;
+
+      //! number of invalid records in the last run
+      unsigned long getNumInvalid() const;
+
+    protected:
+
+      //! cut input into records, returning false if it is malformed
+      bool readBatch(const char *&pos,
+          const char *end,
+          const bool binary,
+          Batch &batch) const;
+
+      //! solve the records of a batch and format their results
+      void solveBatch(Batch &batch,
+          const bool binary,
+          std::unique_ptr<ZeroFinder<double>> &finder,
+          std::vector<std::complex<double>> &coeffs,
+          std::string &line) const;
+
+  };
+}
+
+#endif  // #ifndef _ABERTH_STREAM_H_
@@ -0,0 +1,218 @@
+// includes, system
+#include <vector>
+#include <array>
+#include <string>
+#include <complex>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+// includes, project
+#include "aberth.h"
+#include "aberth_fixed.h"
+#include "tests.h"
+
+/*
+ * Time compZeros across degrees, precisions, initial guesses and families
+ * of polynomials, printing one line of CSV per case so that results of
+ * different versions can be diffed
+ * then compare FixedZeroFinder to ZeroFinder for degrees 2 to 16
+ *
+ * usage: aberth_bench [max degree]
+ */
+
+namespace ab = aberth;
+
+//----------------------------------------------------------------------------//
+//! family of test polynomials
+//----------------------------------------------------------------------------//
+struct Family
+{
+  //! name printed in output
+  const char *name;
+
+  //! largest degree generated by coeffs
+  unsigned int maxDeg;
+
+  //! coeffs of the polynomial of a given degree
+  std::function<std::vector<std::complex<double>>(unsigned int)> coeffs;
+};
+
+//----------------------------------------------------------------------------//
+//! time compZeros for coeffs of type T, repeating small cases until
+//! at least minTime seconds have passed, and print results
+//----------------------------------------------------------------------------//
+template <typename T>
+void bench(const char *family,
+    const char *type,
+    const std::vector<std::complex<double>> &coeffs,
+    const std::string initMode)
+{
+  const double minTime = 0.1;
+
+  // coeffs must be representable in T
+  std::vector<std::complex<T>> typedCoeffs(coeffs.size());
+  for(unsigned int i = 0; i < coeffs.size(); i++) {
+    using std::isfinite;
+    typedCoeffs[i] = static_cast<std::complex<T>>(coeffs[i]);
+    if (!isfinite(abs(typedCoeffs[i]))) return;
+  }
+
+  // zeros stop at the rounding error level, which is reachable in float too
+  unsigned int reps = 0, iters = 0;
+  unsigned long evals = 0;
+  bool conv = true;
+  double time = 0;
+  while (time < minTime) {
+    ab::ZeroFinder<T> finder(typedCoeffs, static_cast<T>(1e-9), 200, initMode);
+    finder.setStopCriterion("bound");
+
+    const auto start = std::chrono::steady_clock::now();
+    conv = finder.compZeros() and conv;
+    time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    iters = finder.getIters();
+    reps++;
+  }
+  time /= reps;
+
+  // evaluations are counted in a solve of their own, as the timed ones
+  // take the default path, without stats
+  ab::ZeroFinder<T> finder(typedCoeffs, static_cast<T>(1e-9), 200, initMode);
+  finder.setStopCriterion("bound");
+  finder.setStats(true);
+  finder.compZeros();
+  evals = finder.getStats().evals;
+
+  // evaluations actually made, as converged zeros may not be evaluated
+  printf("%s,%u,%s,%s,%.6e,%u,%d,%lu,%.6e,%.3f\n", family,
+      static_cast<unsigned int>(coeffs.size() - 1), type, initMode.c_str(), time, iters,
+      conv, evals, evals / time, 1e9 * time / evals);
+  fflush(stdout);
+}
+
+//----------------------------------------------------------------------------//
+//! time solves of random polynomials of degree N by ZeroFinder, constructed
+//! for each solve or reset, and by FixedZeroFinder, and print results
+//! the finders agree bit for bit with scalar sums, which are used here
+//----------------------------------------------------------------------------//
+template <typename T, unsigned int N>
+void benchFixed(const char *type)
+{
+  const unsigned int polys = 64;
+  const double minTime = 0.1;
+
+  // a tolerance that random polynomials reach in float as well
+  const T tol = std::sqrt(std::numeric_limits<T>::epsilon());
+
+  // polynomials, as vectors and as arrays
+  std::srand(N);
+  std::vector<std::vector<std::complex<T>>> coeffs(polys);
+  std::vector<std::array<std::complex<T>, N + 1>> fixedCoeffs(polys);
+  for (unsigned int i = 0; i < polys; i++) {
+    const std::vector<std::complex<double>> c = ab::randomCoeffs(N);
+    coeffs[i].assign(c.begin(), c.end());
+    std::copy(coeffs[i].begin(), coeffs[i].end(), fixedCoeffs[i].begin());
+  }
+
+  // seconds per solve of f(i) for each polynomial, and total iterations
+  auto time = [&](auto f, unsigned long &iters) {
+    unsigned int reps = 0;
+    double total = 0;
+    while (total < minTime) {
+      iters = 0;
+      const auto start = std::chrono::steady_clock::now();
+      for (unsigned int i = 0; i < polys; i++) iters += f(i);
+      total += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      reps++;
+    }
+    return total / (reps * polys);
+  };
+
+  unsigned long newIters, resetIters, fixedIters;
+  const double newTime = time([&](const unsigned int i) {
+      ab::ZeroFinder<T> finder(coeffs[i], tol, 200, "newton");
+      finder.setIsa(ab::simd::Isa::scalar);
+      finder.compZeros();
+      return finder.getIters();}, newIters);
+
+  ab::ZeroFinder<T> finder(coeffs[0], tol, 200, "newton");
+  finder.setIsa(ab::simd::Isa::scalar);
+  const double resetTime = time([&](const unsigned int i) {
+      finder.reset(coeffs[i].data(), N + 1);
+      finder.compZeros();
+      return finder.getIters();}, resetIters);
+
+  ab::FixedZeroFinder<T, N> fixed(fixedCoeffs[0], tol, 200, "newton");
+  const double fixedTime = time([&](const unsigned int i) {
+      fixed.reset(fixedCoeffs[i].data());
+      fixed.compZeros();
+      return fixed.getIters();}, fixedIters);
+
+  printf("%u,%s,%.1f,%.1f,%.1f,%.2f,%d\n", N, type, 1e9 * newTime, 1e9 * resetTime,
+      1e9 * fixedTime, resetTime / fixedTime, newIters == fixedIters and resetIters == fixedIters);
+  fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+  const unsigned int maxDeg = 1 < argc ? std::atoi(argv[1]) : 10000;
+
+  // degrees swept for each family
+  const std::vector<unsigned int> degs = {10, 30, 100, 300, 1000, 3000, 10000};
+
+  // random guesses rarely converge above a few hundred, so they stop here
+  const unsigned int maxRandDeg = 300;
+
+  // extended precision costs tens (DoubleDouble) to hundreds (QuadDouble)
+  // of times as much, so it is timed from newton guesses at low degrees
+  const unsigned int maxExtDeg = 100;
+
+  const std::vector<Family> families = {
+    {"easy", 100, ab::easyCoeffs},
+    {"exp", 10, ab::expCoeffs},
+    {"kam1", 7, [](unsigned int) {return ab::kam1coeffs(1e-10);}},
+    {"unity", 10000, ab::unityRootsCoeffs},
+    {"wilkinson", 20, ab::wilkinsonCoeffs},
+    {"mignotte", 10000, ab::mignotteCoeffs},
+    {"chebyshev", 300, ab::chebyshevCoeffs},
+    {"random", 10000, [](unsigned int deg) {
+      std::srand(deg); return ab::randomCoeffs(deg);}}
+  };
+
+  printf("family,degree,type,init,time_s,iters,converged,evals,evals_per_s,ns_per_eval\n");
+  for (const Family &family : families) {
+
+    // sweep degrees, and include the family's largest degree if below them
+    std::vector<unsigned int> famDegs;
+    for (const unsigned int deg : degs) {
+      if (deg <= std::min(family.maxDeg, maxDeg)) famDegs.push_back(deg);
+    }
+    if (family.maxDeg <= maxDeg and (famDegs.empty() or famDegs.back() < family.maxDeg)) {
+      famDegs.push_back(family.maxDeg);
+    }
+
+    for (const unsigned int deg : famDegs) {
+      const std::vector<std::complex<double>> coeffs = family.coeffs(deg);
+      for (const char *initMode : {"rand", "symm", "newton"}) {
+        if (maxRandDeg < deg and std::string(initMode) != "newton") continue;
+        bench<float>(family.name, "float", coeffs, initMode);
+        bench<double>(family.name, "double", coeffs, initMode);
+        if (deg <= maxExtDeg and std::string(initMode) == "newton") {
+          bench<ab::DoubleDouble>(family.name, "dd", coeffs, initMode);
+          bench<ab::QuadDouble>(family.name, "qd", coeffs, initMode);
+        }
+      }
+    }
+  }
+
+  // tiny degrees, where ZeroFinder's dynamic storage costs more than the math
+  printf("\ndegree,type,new_ns,reset_ns,fixed_ns,speedup,same_iters\n");
+  ab::unroll(std::make_integer_sequence<unsigned int, 15>(), [](auto k) {
+    benchFixed<float, decltype(k)::value + 2>("float");
+    benchFixed<double, decltype(k)::value + 2>("double");
+  });
+}
@@ -0,0 +1,104 @@
+// includes, system
+#include <string>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cfloat>
+#include <cerrno>
+#include <climits>
+#include <thread>
+#include <algorithm>
+
+// includes, project
+#include "aberth_stream.h"
+
+/*
+ * Solve every polynomial of a file, writing their zeros to another file
+ * formats of input and output are described in aberth_stream.h
+ *
+ * usage: aberth_cli [-j threads] [-b batch size] [-q queue depth]
+ *                   [-t tol] [-m max iterations] [-i rand|symm|newton]
+ *                   input output
+ */
+
+//----------------------------------------------------------------------------//
+//! print usage and exit
+//----------------------------------------------------------------------------//
+static void usage()
+{
+  fprintf(stderr, "usage: aberth_cli [-j threads] [-b batch size] [-q queue depth]\n"
+                  "                  [-t tol] [-m max iterations] [-i rand|symm|newton]\n"
+                  "                  input output\n");
+  exit(2);
+}
+
+//----------------------------------------------------------------------------//
+//! parse a count from 1 to max, or print usage and exit
+//----------------------------------------------------------------------------//
+static unsigned int parseCount(const char *value, const unsigned long max)
+{
+  char *end;
+  errno = 0;
+  const unsigned long count = std::strtoul(value, &end, 10);
+  if (value[0] == '-' or end == value or *end or errno or !count or max < count) usage();
+  return count;
+}
+
+//----------------------------------------------------------------------------//
+//! parse a tolerance of at least the smallest normal double, or print usage
+//! and exit
+//----------------------------------------------------------------------------//
+static double parseTol(const char *value)
+{
+  char *end;
+  errno = 0;
+  const double tol = std::strtod(value, &end);
+  if (end == value or *end or errno or !(DBL_MIN <= tol and tol <= DBL_MAX)) usage();
+  return tol;
+}
+
+int main(int argc, char **argv)
+{
+  double tol = 1e-9;
+  unsigned int maxIters = 200,
+               nThreads = 0,
+               batchSize = 256,
+               queueDepth = 4;
+  std::string initMode = "newton";
+
+  // threads beyond a few per core only add contention
+  const unsigned long maxThreads = 4ul * std::max(1u, std::thread::hardware_concurrency());
+
+  // options, then input and output
+  int a = 1;
+  for (; a + 1 < argc and argv[a][0] == '-' and strlen(argv[a]) == 2; a += 2) {
+    const char *value = argv[a + 1];
+    switch (argv[a][1]) {
+      case 'j': nThreads = parseCount(value, maxThreads); break;
+      case 'b': batchSize = parseCount(value, UINT_MAX); break;
+      case 'q': queueDepth = parseCount(value, UINT_MAX); break;
+      case 't': tol = parseTol(value); break;
+      case 'm': maxIters = parseCount(value, UINT_MAX); break;
+      case 'i': initMode = value; break;
+      default: usage();
+    }
+  }
+  if (a + 2 != argc or
+      (initMode != "rand" and initMode != "symm" and initMode != "newton")) usage();
+
+  aberth::StreamSolver solver(tol, maxIters, initMode);
+  solver.setNumThreads(nThreads);
+  solver.setBatchSize(batchSize);
+  solver.setQueueDepth(queueDepth);
+
+  const auto start = std::chrono::steady_clock::now();
+  const bool ok = solver.run(argv[a], argv[a + 1]);
+  const double time = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  fprintf(stderr, "%lu polynomials, %lu converged, %lu invalid, %.3f s\n",
+      solver.getNumPolys(), solver.getNumConv(), solver.getNumInvalid(), time);
+  if (!ok) {fprintf(stderr, "aberth_cli: %s\n", solver.getError().c_str()); return 1;}
+  return 0;
+}
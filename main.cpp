@@ -1,11 +1,43 @@
 #include <vector>
+#include <array>
+#include <algorithm>
 #include <cassert>
 #include <complex>
+#include <cstdlib>
+#include <new>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cfloat>
+#include <chrono>
+#include <thread>
+#include <type_traits>
+#include <unistd.h>
 
 // includes, project
 #include "aberth.h"
+#include "aberth_simd.h"
+#include "aberth_fmm.h"
+#include "aberth_fixed.h"
+#include "aberth_stream.h"
 #include "tests.h"
 
+// count heap allocations, to check that reused finders make none
+// (every replaceable form is replaced, so that each delete matches its new)
+static unsigned long numAllocs = 0;
+static void *countedAlloc(const std::size_t size)
+{
+  numAllocs++;
+  if (void *ptr = std::malloc(size ? size : 1)) return ptr;
+  throw std::bad_alloc();
+}
+void *operator new(std::size_t size) {return countedAlloc(size);}
+void *operator new[](std::size_t size) {return countedAlloc(size);}
+void operator delete(void *ptr) noexcept {std::free(ptr);}
+void operator delete[](void *ptr) noexcept {std::free(ptr);}
+void operator delete(void *ptr, std::size_t) noexcept {std::free(ptr);}
+void operator delete[](void *ptr, std::size_t) noexcept {std::free(ptr);}
+
 int main()
 {
 
@@ -28,13 +60,13 @@ int main()
     coeffs = ab::easyCoeffs(10 * i);
 
     // initialize class
-    ab::ZeroFinder<double> *finder = new ab::ZeroFinder<double>(coeffs);
+    ab::ZeroFinder<double> finder(coeffs);
     
     // compute zeros
-    passed = finder->compZeros();
+    passed = finder.compZeros();
 
     // copy zeros (for demonstration)
-    std::vector<std::complex<double>> zeros = finder->getZeros();
+    std::vector<std::complex<double>> zeros = finder.getZeros();
 
     // die if test failed
     if (!passed) {printf("Failed \"Easy\" polynomial with degree %u\n", i); exit(1);}
@@ -45,9 +77,9 @@ int main()
   printf("Testing \"Exp\" polynomials...\n");
   for(unsigned int i = 1; i <= 10; i++) {
     coeffs = ab::expCoeffs(i);
-    ab::ZeroFinder<double> *finder = new ab::ZeroFinder<double>(coeffs);
-    passed = finder->compZeros();
-    zeros = finder->getZeros();
+    ab::ZeroFinder<double> finder(coeffs);
+    passed = finder.compZeros();
+    zeros = finder.getZeros();
     if (!passed) {printf("Failed \"Exp\" polynomial with degree %u\n", i); exit(1);}
   }
 
@@ -55,20 +87,851 @@ int main()
   for(unsigned int i = 1; i <= 10; i++) {
     double c = 1e-6 / (i*10);
     coeffs = ab::kam1coeffs(c);
-    ab::ZeroFinder<double> *finder = new ab::ZeroFinder<double>(coeffs);
-    passed = finder->compZeros();
-    zeros = finder->getZeros();
+    ab::ZeroFinder<double> finder(coeffs);
+    passed = finder.compZeros();
+    zeros = finder.getZeros();
     if (!passed) {printf("Failed \"kam1\" polynomial with c = %f\n", c); exit(1);}
   }
 
   printf("Testing \"roots of unity\" polynomials...\n");
   for(unsigned int i = 1; i <= 10; i++) {
     coeffs = ab::unityRootsCoeffs(i);
-    ab::ZeroFinder<double> *finder = new ab::ZeroFinder<double>(coeffs);
-    passed = finder->compZeros();
-    zeros = finder->getZeros();
+    ab::ZeroFinder<double> finder(coeffs);
+    passed = finder.compZeros();
+    zeros = finder.getZeros();
     if (!passed) {printf("Failed \"roots of unity\" polynomial with degree %u\n", i); exit(1);}
   }
 
+  printf("Testing batched polynomials...\n");
+  {
+    // perturbed "easy" polynomials of the same degree
+    std::vector<std::vector<std::complex<double>>> batch(100);
+    for(unsigned int i = 0; i < batch.size(); i++) {
+      batch[i] = ab::easyCoeffs(20);
+      batch[i][0] += static_cast<std::complex<double>>(0.01 * i);
+    }
+    ab::BatchZeroFinder<double> finder(batch);
+    passed = finder.compZeros();
+    if (!passed) {printf("Failed batched polynomials\n"); exit(1);}
+
+    // check each zero against its own polynomial
+    for(unsigned int i = 0; i < batch.size(); i++) {
+      ab::Polynomial<double> poly(batch[i]);
+      for (auto zero : finder.getZeros(i)) {
+        if (!(abs(poly.eval(zero)) < 1e-9)) {
+          printf("Failed batched polynomial %u\n", i); exit(1);
+        }
+      }
+    }
+  }
+
+  printf("Testing vectorized compInvDiffSum...\n");
+  {
+    // zeros on a perturbed circle, with a length that leaves scalar tails
+    const unsigned int n = 103;
+    std::vector<double> re(n), im(n);
+    std::vector<float> reF(n), imF(n);
+    for(unsigned int i = 0; i < n; i++) {
+      re[i] = cos(0.1 * i) * (1 + 0.01 * i); im[i] = sin(0.1 * i);
+      reF[i] = re[i]; imF[i] = im[i];
+    }
+
+    // every supported level agrees with the scalar kernel and repeats exactly
+    for (int l = 0; l <= static_cast<int>(ab::simd::detectIsa()); l++) {
+      const ab::simd::Isa isa = static_cast<ab::simd::Isa>(l);
+      for(unsigned int i = 0; i < n; i++) {
+        double sRe, sIm, tRe, tIm, uRe, uIm;
+        float fRe, fIm, gRe, gIm;
+        ab::simd::invDiffSumRow(re.data(), im.data(), n, i, sRe, sIm, isa);
+        ab::simd::invDiffSumRow(re.data(), im.data(), n, i, tRe, tIm, isa);
+        ab::simd::invDiffSumRow(re.data(), im.data(), n, i, uRe, uIm,
+            ab::simd::Isa::scalar);
+        ab::simd::invDiffSumRow(reF.data(), imF.data(), n, i, fRe, fIm, isa);
+        ab::simd::invDiffSumRow(reF.data(), imF.data(), n, i, gRe, gIm,
+            ab::simd::Isa::scalar);
+        if (sRe != tRe or sIm != tIm or
+            1e-10 < abs(std::complex<double>(sRe - uRe, sIm - uIm)) or
+            1e-2 < abs(std::complex<float>(fRe - gRe, fIm - gIm))) {
+          printf("Failed vectorized compInvDiffSum with isa %s\n",
+              ab::simd::isaName(isa));
+          exit(1);
+        }
+      }
+    }
+  }
+
+  printf("Testing multithreaded iteration...\n");
+  {
+    // same initial guesses for serial and parallel finders
+    coeffs = ab::easyCoeffs(100);
+    ab::ZeroFinder<double> serial(coeffs);
+    ab::ZeroFinder<double> parallel(coeffs);
+    parallel.setNumThreads(4);
+
+    // Jacobi sweeps must give exactly the same zeros
+    passed = serial.compZeros() and parallel.compZeros() and
+      serial.getZeros() == parallel.getZeros();
+    if (!passed) {printf("Failed multithreaded iteration\n"); exit(1);}
+
+    // loops nested in a chunk of the same pool cover their range instead
+    // of waiting for busy threads
+    ab::ThreadPool pool(4);
+    std::vector<unsigned int> covered(16, 0);
+    pool.parallelFor(4, [&pool, &covered](const unsigned int b, const unsigned int e,
+          const unsigned int) {
+      for (unsigned int i = b; i < e; i++) {
+        pool.parallelFor(4, [&covered, i](const unsigned int bb, const unsigned int ee,
+              const unsigned int) {for (unsigned int j = bb; j < ee; j++) covered[4 * i + j]++;});
+      }
+    });
+    passed = std::all_of(covered.cbegin(), covered.cend(), [](const unsigned int c) {return c == 1;});
+    if (!passed) {printf("Failed nested parallel loops\n"); exit(1);}
+  }
+
+  printf("Testing fast multipole sums...\n");
+  {
+    // random zeros in the unit square
+    const unsigned int n = 2000;
+    std::vector<double> re(n), im(n);
+    std::vector<std::complex<double>> sums(n);
+    for(unsigned int i = 0; i < n; i++) {
+      re[i] = static_cast<double>(std::rand()) / RAND_MAX;
+      im[i] = static_cast<double>(std::rand()) / RAND_MAX;
+    }
+
+    // approximate sums are within a few multiples of the requested accuracy
+    ab::CauchyFmm fmm(1e-6);
+    fmm.compSums(re.data(), im.data(), n, sums.data());
+    for(unsigned int i = 0; i < n; i++) {
+      double sRe, sIm;
+      ab::simd::invDiffSumRow(re.data(), im.data(), n, i, sRe, sIm,
+          ab::simd::Isa::scalar);
+      const std::complex<double> s = {sRe, sIm};
+      if (1e-5 * abs(s) < abs(sums[i] - s)) {
+        printf("Failed fast multipole sums at zero %u\n", i); exit(1);
+      }
+    }
+
+    // at the degrees the sums are meant for, zeros of random polynomials
+    // crowd near the unit circle, and a sample of rows is checked
+    const unsigned int big = 100000;
+    re.resize(big);
+    im.resize(big);
+    sums.resize(big);
+    for(unsigned int i = 0; i < big; i++) {
+      const double r = 1 + 1e-3 * std::rand() / RAND_MAX,
+                   angle = 2 * M_PI * std::rand() / RAND_MAX;
+      re[i] = r * std::cos(angle);
+      im[i] = r * std::sin(angle);
+    }
+    fmm.compSums(re.data(), im.data(), big, sums.data());
+    for(unsigned int i = 0; i < big; i += 997) {
+      double sRe, sIm;
+      ab::simd::invDiffSumRow(re.data(), im.data(), big, i, sRe, sIm,
+          ab::simd::Isa::scalar);
+      const std::complex<double> s = {sRe, sIm};
+      if (1e-5 * abs(s) < abs(sums[i] - s)) {
+        printf("Failed fast multipole sums at zero %u of %u\n", i, big); exit(1);
+      }
+    }
+
+    // approximate sums still lead to converged zeros
+    ab::ZeroFinder<double> finder(ab::easyCoeffs(100));
+    finder.setSumMode("fmm", 1e-3);
+    passed = finder.compZeros();
+    if (!passed) {printf("Failed fast multipole iteration\n"); exit(1);}
+  }
+
+  printf("Testing active-set iteration...\n");
+  for(unsigned int i = 1; i <= 10; i++) {
+    coeffs = ab::kam1coeffs(1e-6 / (i*10));
+    ab::ZeroFinder<double> finder(coeffs);
+    finder.setActiveSet(true);
+    passed = finder.compZeros();
+
+    // frozen zeros must still satisfy the tolerance
+    for (auto zero : finder.getZeros()) {
+      if (!(abs(finder.eval(zero)) < 1e-9)) passed = false;
+    }
+    if (!passed) {printf("Failed active-set iteration with c = %e\n", 1e-6 / (i*10)); exit(1);}
+  }
+
+  printf("Testing update orders and initial guesses...\n");
+  {
+    // coefficients of each family, as in the tests above
+    std::vector<std::pair<const char *, std::vector<std::vector<std::complex<double>>>>>
+      families = {{"Easy", {}}, {"Exp", {}}, {"kam1", {}}, {"roots of unity", {}}};
+    for(unsigned int i = 1; i <= 10; i++) {
+      families[0].second.push_back(ab::easyCoeffs(10 * i));
+      families[1].second.push_back(ab::expCoeffs(i));
+      families[2].second.push_back(ab::kam1coeffs(1e-6 / (i*10)));
+      families[3].second.push_back(ab::unityRootsCoeffs(i));
+    }
+
+    // total iterations of each method of initializing zeros
+    for (const auto &family : families) {
+      const char *modes[3] = {"rand", "symm", "newton"};
+      unsigned int iters[3] = {0, 0, 0};
+      for (const auto &familyCoeffs : family.second) {
+        for (unsigned int m = 0; m < 3; m++) {
+          ab::ZeroFinder<double> finder(familyCoeffs, 1e-9, 200, modes[m]);
+          passed = finder.compZeros();
+          iters[m] += finder.getIters();
+          if (!passed and m == 2) {printf("Failed Newton polygon guesses\n"); exit(1);}
+        }
+      }
+      printf("  %-16s rand %4u, symm %4u, newton %4u iterations\n", family.first,
+          iters[0], iters[1], iters[2]);
+    }
+
+    // total iterations of each update mode from the same initial guesses
+    for (const auto &family : families) {
+      unsigned int iters[2] = {0, 0};
+      for (const auto &familyCoeffs : family.second) {
+        for (unsigned int m = 0; m < 2; m++) {
+          ab::ZeroFinder<double> finder(familyCoeffs);
+          finder.setUpdateMode(m ? "seidel" : "jacobi");
+          passed = finder.compZeros();
+          iters[m] += finder.getIters();
+          if (!passed) {printf("Failed Gauss-Seidel iteration\n"); exit(1);}
+        }
+      }
+      printf("  %-16s jacobi %4u, seidel %4u iterations\n", family.first,
+          iters[0], iters[1]);
+    }
+  }
+
+  printf("Testing mixed precision...\n");
+  for(unsigned int i = 1; i <= 10; i++) {
+
+    // float iterations polished in double meet the same tolerance
+    coeffs = ab::easyCoeffs(10 * i);
+    ab::ZeroFinder<double> finder(coeffs, 1e-9, 200, "newton");
+    finder.setPrecisionMode("mixed");
+    passed = finder.compZeros();
+    for (auto zero : finder.getZeros()) {
+      if (!(abs(finder.eval(zero)) < 1e-9)) passed = false;
+    }
+    if (!passed) {printf("Failed mixed precision with n = %u\n", 10 * i); exit(1);}
+
+    // and in long double, to a tolerance out of reach of double
+    std::vector<std::complex<long double>> longCoeffs(coeffs.begin(), coeffs.end());
+    ab::ZeroFinder<long double> longFinder(longCoeffs, 1e-15L, 200, "newton");
+    longFinder.setPrecisionMode("mixed");
+    passed = longFinder.compZeros();
+    if (!passed) {printf("Failed long double polishing with n = %u\n", 10 * i); exit(1);}
+  }
+
+  printf("Testing error-bound stopping and inclusion radii...\n");
+  for(unsigned int i = 10; i <= 20; i += 5) {
+
+    // |p| < tol is out of reach, but the rounding error level is not
+    coeffs = ab::wilkinsonCoeffs(i);
+    ab::ZeroFinder<double> finder(coeffs, 1e-9, 200, "newton");
+    finder.setStopCriterion("bound");
+    passed = finder.compZeros();
+
+    // each k = 1, ..., i lies in the disc about some zero
+    zeros = finder.getZeros();
+    const std::vector<double> radii = finder.getRadii();
+    for(unsigned int k = 1; k <= i; k++) {
+      bool inside = false;
+      for(unsigned int j = 0; j < i; j++) {
+        if (abs(zeros[j] - static_cast<double>(k)) <= radii[j]) inside = true;
+      }
+      if (!inside) passed = false;
+    }
+    if (!passed) {printf("Failed error-bound stopping with n = %u\n", i); exit(1);}
+  }
+
+  printf("Testing real coefficients...\n");
+  {
+    // random real coeffs and Mignotte polynomials have real and complex zeros
+    std::srand(8008335);
+    std::vector<std::vector<std::complex<double>>> reals;
+    for(unsigned int i = 1; i <= 4; i++) {
+      reals.push_back(ab::randomCoeffs(50 * i));
+      for (auto &coeff : reals.back()) coeff = coeff.real();
+      reals.push_back(ab::mignotteCoeffs(25 * i));
+    }
+
+    // pairs are evaluated once for both of their zeros, once zeros have
+    // sorted themselves into pairs
+    unsigned long evals[2] = {0, 0};
+    for (const auto &realCoeffs : reals) {
+      for (unsigned int m = 0; m < 2; m++) {
+        ab::ZeroFinder<double> finder(realCoeffs, 1e-9, 200, "newton");
+        finder.setStopCriterion("bound");
+        finder.setRealCoeffs(m);
+        finder.setStats(true);
+        passed = finder.compZeros();
+        evals[m] += finder.getStats().evals;
+
+        // conjugate of each zero is a zero too
+        zeros = finder.getZeros();
+        for (const auto &zero : zeros) {
+          double dist = abs(zero);
+          for (const auto &other : zeros) dist = std::min(dist, abs(std::conj(zero) - other));
+          if (!(dist <= 1e-6 * (1 + abs(zero)))) passed = false;
+        }
+        if (!passed) {printf("Failed real coeffs with n = %u\n", static_cast<unsigned int>(zeros.size())); exit(1);}
+      }
+    }
+    printf("  complex %lu, real %lu evaluations\n", evals[0], evals[1]);
+    if (evals[0] <= evals[1]) {printf("Failed real coeffs evaluations\n"); exit(1);}
+
+    // all zeros of chebyshev polynomials are real, so no pairs form, and
+    // the zeros take no more sweeps or evaluations than for complex coeffs
+    for (const unsigned int n : {10, 20}) {
+      coeffs = ab::chebyshevCoeffs(n);
+      ab::ZeroFinder<double> complex(coeffs, 1e-9, 200, "newton"),
+                             real(coeffs, 1e-9, 200, "newton");
+      complex.setStopCriterion("bound");
+      real.setStopCriterion("bound");
+      complex.setStats(true);
+      real.setStats(true);
+      real.setRealCoeffs(true);
+      passed = complex.compZeros() and real.compZeros() and
+        real.getIters() <= complex.getIters() and
+        real.getStats().evals <= complex.getStats().evals;
+      for (const auto &zero : real.getZeros()) {
+        if (!(std::abs(zero.imag()) <= 1e-9)) passed = false;
+      }
+      printf("  chebyshev %u: complex %lu, real %lu evaluations\n", n,
+          complex.getStats().evals, real.getStats().evals);
+      if (!passed) {printf("Failed real coeffs with chebyshev %u\n", n); exit(1);}
+    }
+  }
+
+  printf("Testing cluster detection...\n");
+  {
+    // triple zero at 1, double zero at -2, and simple zeros at i and 3
+    const std::vector<std::complex<double>> roots = {1, 1, 1, -2, -2, {0, 1}, 3};
+    std::vector<std::complex<double>> multCoeffs = {1};
+    for (const auto &root : roots) {
+      multCoeffs.insert(multCoeffs.begin(), 0);
+      for(unsigned int i = 0; i + 1 < multCoeffs.size(); i++) multCoeffs[i] -= root * multCoeffs[i + 1];
+    }
+
+    // clusters converge in fewer iterations, much closer to the zeros,
+    // each of whose multiplicities is found
+    ab::ZeroFinder<double> plain(multCoeffs, 1e-9, 200, "newton"),
+                           clustered(multCoeffs, 1e-9, 200, "newton");
+    clustered.setClusterDetection(true);
+    passed = plain.compZeros() and clustered.compZeros() and
+      clustered.getIters() < plain.getIters();
+    for(unsigned int i = 0; i < roots.size(); i++) {
+      const std::complex<double> zero = clustered.getZeros()[i];
+      unsigned int mult = 0;
+      for (const auto &root : roots) mult += abs(zero - root) < 1e-6;
+      if (clustered.getMultiplicities()[i] != mult) passed = false;
+    }
+
+    // a zero of multiplicity 8 amid simple zeros on the unit circle is found
+    // with either stop criterion, even once its zeros meet tol one by one
+    std::vector<std::complex<double>> highRoots(8, {0.5, 0.3});
+    for(unsigned int k = 0; k < 10; k++) highRoots.push_back(std::polar(1.0, 2 * M_PI * k / 10 + 0.1));
+    std::vector<std::complex<double>> highCoeffs = {1};
+    for (const auto &root : highRoots) {
+      highCoeffs.insert(highCoeffs.begin(), 0);
+      for(unsigned int i = 0; i + 1 < highCoeffs.size(); i++) highCoeffs[i] -= root * highCoeffs[i + 1];
+    }
+    for (const auto &[stop, tol] : {std::make_pair("bound", 1e-9), std::make_pair("tol", 1e-13)}) {
+      ab::ZeroFinder<double> high(highCoeffs, tol, 500, "newton");
+      high.setStopCriterion(stop);
+      high.setClusterDetection(true);
+      passed = high.compZeros() and passed;
+      const std::vector<unsigned int> mults = high.getMultiplicities();
+      if (std::count(mults.cbegin(), mults.cend(), 8) != 8 or
+          std::count(mults.cbegin(), mults.cend(), 1) != 10) passed = false;
+      for(unsigned int i = 0; i < mults.size(); i++) {
+        if (mults[i] == 8 and !(abs(high.getZeros()[i] - highRoots[0]) < 1e-2)) passed = false;
+      }
+    }
+
+    // polynomials with simple zeros find no clusters, so nothing changes
+    coeffs = ab::easyCoeffs(100);
+    ab::ZeroFinder<double> simple(coeffs, 1e-9, 200, "newton"),
+                           detecting(coeffs, 1e-9, 200, "newton");
+    detecting.setClusterDetection(true);
+    simple.compZeros();
+    detecting.compZeros();
+    if (simple.getZeros() != detecting.getZeros() or
+        std::count(detecting.getMultiplicities().cbegin(),
+          detecting.getMultiplicities().cend(), 1) != 100) passed = false;
+    if (!passed) {printf("Failed cluster detection\n"); exit(1);}
+  }
+
+  printf("Testing warm starts...\n");
+  {
+    // coeffs drifting a little from one step to the next
+    coeffs = ab::easyCoeffs(50);
+    ab::ZeroFinder<double> finder(coeffs, 1e-9, 200, "newton");
+    passed = finder.compZeros();
+    unsigned int cold = finder.getIters(), warm = 0;
+    for(unsigned int step = 1; step <= 10; step++) {
+      const std::vector<std::complex<double>> prev = finder.getZeros();
+      for(unsigned int i = 0; i < coeffs.size(); i++) {
+        coeffs[i] += std::polar(1e-3, static_cast<double>(step * i));
+      }
+      finder.update(coeffs);
+      passed = finder.compZeros() and passed;
+
+      // each step takes at most half the iterations of a cold start
+      warm += finder.getIters();
+      if (cold < 2 * finder.getIters()) passed = false;
+
+      // origins are a permutation, taking each zero back to the nearest
+      // of the previous zeros
+      zeros = finder.getZeros();
+      const std::vector<unsigned int> origins = finder.getOrigins();
+      std::vector<bool> taken(zeros.size(), false);
+      for(unsigned int i = 0; i < zeros.size(); i++) {
+        if (zeros.size() <= origins[i] or taken[origins[i]]) {passed = false; break;}
+        taken[origins[i]] = true;
+        for(unsigned int j = 0; j < prev.size(); j++) {
+          if (abs(zeros[i] - prev[j]) < abs(zeros[i] - prev[origins[i]])) passed = false;
+        }
+      }
+    }
+    printf("  cold %u, warm %.1f iterations per step\n", cold, warm / 10.);
+    if (!passed) {printf("Failed warm starts\n"); exit(1);}
+  }
+
+  printf("Testing solve statistics...\n");
+  {
+    ab::ZeroFinder<double> finder(ab::easyCoeffs(100), 1e-9, 200, "newton");
+    finder.setActiveSet(true);
+    ab::ZeroFinder<double> quiet(finder);
+    finder.setStats(true);
+
+    // callback sees every iteration, with fewer active zeros each time
+    unsigned int calls = 0, lastRows = 100;
+    finder.setIterCallback([&](const ab::SolveStats<double> &stats) {
+      calls++;
+      if (stats.iters != calls or lastRows < stats.activeRows.back()) passed = false;
+      lastRows = stats.activeRows.back();
+    });
+    passed = finder.compZeros() and passed;
+
+    // each updated zero is evaluated once per iteration
+    const ab::SolveStats<double> stats = finder.getStats();
+    unsigned long rows = 0;
+    for (const unsigned int nRows : stats.activeRows) rows += nRows;
+    if (stats.iters != finder.getIters() or calls != stats.iters or stats.evals != rows or
+        stats.forwardEvals + stats.reverseEvals != stats.evals or
+        !(stats.maxResid < 1e-9) or !(0 < stats.sumTime and 0 < stats.stepTime) or
+        stats.status != ab::SolveStatus::converged) passed = false;
+    // without setStats, only iterations, residuals and status are kept,
+    // and the zeros are the same
+    passed = quiet.compZeros() and passed;
+    const ab::SolveStats<double> &quietStats = quiet.getStats();
+    if (quietStats.iters != stats.iters or quietStats.evals or !quietStats.activeRows.empty() or
+        quietStats.sumTime or quietStats.maxResid != stats.maxResid or
+        quiet.getZeros() != finder.getZeros()) passed = false;
+    printf("  %u iterations, %lu evaluations (%lu reverse), %.2e s in sums, %.2e s in steps\n",
+        stats.iters, stats.evals, stats.reverseEvals, stats.sumTime, stats.stepTime);
+    if (!passed) {printf("Failed solve statistics\n"); exit(1);}
+  }
+
+  printf("Testing deadlines and cancellation...\n");
+  {
+    coeffs = ab::easyCoeffs(100);
+    ab::ZeroFinder<double> finder(coeffs, 1e-9, 200, "newton");
+    ab::ZeroFinder<double> reference(finder);
+    reference.compZeros();
+
+    // cancelled once some zeros converged, the rest are left as they were
+    ab::CancelToken token;
+    unsigned int cancelledAt = 0;
+    finder.setIterCallback([&](const ab::SolveStats<double> &stats) {
+      const std::vector<unsigned char> &conv = finder.getConv();
+      if (!cancelledAt and std::count(conv.begin(), conv.end(), 1)) {
+        cancelledAt = stats.iters;
+        token.cancel();
+      }
+    });
+    ab::SolveResult<double> result = finder.compZerosAsync(
+        std::chrono::steady_clock::time_point::max(), token).get();
+    const unsigned int nConv = std::count(result.conv.begin(), result.conv.end(), 1);
+    passed = result.status == ab::SolveStatus::cancelled and result.iters == cancelledAt and
+      result.zeros.size() == 100 and result.resids.size() == 100 and 0 < nConv and nConv < 100;
+    for(unsigned int i = 0; i < 100; i++) {
+      if (result.conv[i] and !(result.resids[i] < 1e-9)) passed = false;
+    }
+
+    // a later solve resumes, no longer holding the cancelled token, ending
+    // near where an uninterrupted one would (zeros were sorted when stopped,
+    // so sums are added in another order)
+    finder.setIterCallback(nullptr);
+    passed = finder.compZeros() and passed;
+    passed = passed and finder.getStats().status == ab::SolveStatus::converged;
+    for(unsigned int i = 0; i < 100; i++) {
+      if (!(abs(finder.getZeros()[i] - reference.getZeros()[i]) < 1e-6)) passed = false;
+    }
+
+    // a solve that can't converge stops at its deadline, or once cancelled
+    // from another thread
+    for (unsigned int m = 0; m < 2; m++) {
+      ab::ZeroFinder<double> stuck(coeffs, DBL_MIN, 1000000);
+      ab::CancelToken stop;
+      const auto start = std::chrono::steady_clock::now();
+      std::future<ab::SolveResult<double>> future = stuck.compZerosAsync(m ?
+          std::chrono::steady_clock::time_point::max() : start + std::chrono::milliseconds(20), stop);
+      if (m) {std::this_thread::sleep_for(std::chrono::milliseconds(20)); stop.cancel();}
+      result = future.get();
+      if (result.status != (m ? ab::SolveStatus::cancelled : ab::SolveStatus::deadline) or
+          std::chrono::seconds(2) < std::chrono::steady_clock::now() - start or
+          result.zeros.size() != 100) passed = false;
+    }
+
+    // nor does a passed deadline outlive its solve
+    ab::ZeroFinder<double> late(coeffs, 1e-9, 200, "newton");
+    result = late.compZerosAsync(std::chrono::steady_clock::now()).get();
+    passed = result.status == ab::SolveStatus::deadline and late.compZeros() and passed;
+    if (!passed) {printf("Failed deadlines and cancellation\n"); exit(1);}
+  }
+
+  printf("Testing reuse without allocation...\n");
+  {
+    // largest degree first, so that later polynomials fit in its buffers
+    std::vector<std::vector<std::complex<double>>> stream;
+    for(unsigned int i = 10; 1 <= i; i--) {
+      stream.push_back(ab::easyCoeffs(10 * i));
+      stream.push_back(ab::unityRootsCoeffs(i));
+    }
+    // sparse coeffs right after dense ones of the same degree
+    stream.insert(stream.begin() + 1, ab::unityRootsCoeffs(100));
+    const std::vector<ab::Polynomial<double>> polys(stream.begin(), stream.end());
+    // adaptive solves whose zeros all meet tol in double build no wider
+    // finder, so they make none either
+    for (const auto &[initMode, precisionMode] : {std::make_pair("rand", "full"),
+          std::make_pair("newton", "full"), std::make_pair("newton", "adaptive")}) {
+      ab::ZeroFinder<double> finder(stream[0], 1e-9, 200, initMode);
+      finder.setPrecisionMode(precisionMode);
+      finder.setActiveSet(true);
+      passed = finder.compZeros();
+      const unsigned long before = numAllocs;
+      for(unsigned int i = 0; i < stream.size(); i++) {
+        finder.reset(stream[i].data(), stream[i].size());
+        passed = finder.compZeros() and passed;
+        for (const auto &zero : finder.getZeros()) {
+          if (!(abs(polys[i].eval(zero)) < 1e-9)) passed = false;
+        }
+      }
+      if (!passed or numAllocs != before) {
+        printf("Failed reuse with %lu allocations\n", numAllocs - before); exit(1);
+      }
+    }
+  }
+
+  printf("Testing fixed-degree solver...\n");
+  {
+    // same zeros as ZeroFinder with scalar sums, from the same guesses
+    auto compare = [&passed](auto n) {
+      constexpr unsigned int N = decltype(n)::value;
+      for (const char *initMode : {"rand", "symm", "newton"}) {
+        for(unsigned int i = 0; i < 10; i++) {
+          const std::vector<std::complex<double>> coeffs = ab::randomCoeffs(N);
+          std::array<std::complex<double>, N + 1> fixedCoeffs;
+          std::copy(coeffs.begin(), coeffs.end(), fixedCoeffs.begin());
+          ab::ZeroFinder<double> finder(coeffs, 1e-9, 200, initMode);
+          finder.setIsa(ab::simd::Isa::scalar);
+          finder.setSeed(i);
+          ab::FixedZeroFinder<double, N> fixed(fixedCoeffs, 1e-9, 200, initMode);
+          fixed.setSeed(i);
+          const bool conv = finder.compZeros();
+          const unsigned long before = numAllocs;
+          if (conv != fixed.compZeros() or numAllocs != before or
+              finder.getIters() != fixed.getIters() or
+              !std::equal(fixed.getZeros().begin(), fixed.getZeros().end(),
+                finder.getZeros().begin())) passed = false;
+        }
+      }
+    };
+    compare(std::integral_constant<unsigned int, 2>());
+    compare(std::integral_constant<unsigned int, 5>());
+    compare(std::integral_constant<unsigned int, 16>());
+    if (!passed) {printf("Failed fixed-degree solver\n"); exit(1);}
+  }
+
+  printf("Testing streaming pipeline...\n");
+  {
+    // text input with a blank line, a comment and an invalid record, and the
+    // same polynomials as binary input
+    std::vector<std::vector<std::complex<double>>> polys;
+    for(unsigned int i = 1; i <= 20; i++) polys.push_back(ab::easyCoeffs(5 * i));
+    polys.push_back({1});
+    char inText[] = "/tmp/aberthXXXXXX", inBin[] = "/tmp/aberthXXXXXX",
+         outText[] = "/tmp/aberthXXXXXX", outBin[] = "/tmp/aberthXXXXXX";
+    for (char *path : {inText, inBin, outText, outBin}) close(mkstemp(path));
+    FILE *text = fopen(inText, "w"), *bin = fopen(inBin, "wb");
+    fwrite(ab::StreamSolver::INPUT_MAGIC, 1, 8, bin);
+    for(unsigned int i = 0; i < polys.size(); i++) {
+      const uint32_t n = polys[i].size();
+      fwrite(&n, 4, 1, bin);
+      fwrite(polys[i].data(), 16, n, bin);
+      for (const auto &coeff : polys[i]) fprintf(text, "%.17g %.17g ", coeff.real(), coeff.imag());
+      fprintf(text, i == 3 ? "\n\n# comment\n" : "\n");
+    }
+    fclose(text);
+    fclose(bin);
+
+    // small batches and queues, so that batches finish out of order
+    ab::StreamSolver solver;
+    solver.setNumThreads(3);
+    solver.setBatchSize(2);
+    solver.setQueueDepth(1);
+    passed = solver.run(inText, outText) and solver.getNumPolys() == polys.size() and
+      solver.getNumConv() == polys.size() - 1 and solver.getNumInvalid() == 1;
+    passed = solver.run(inBin, outBin) and solver.getNumPolys() == polys.size() and passed;
+
+    // both outputs hold the same zeros, in input order
+    text = fopen(outText, "r");
+    bin = fopen(outBin, "rb");
+    char magic[8];
+    if (fread(magic, 1, 8, bin) != 8 or memcmp(magic, ab::StreamSolver::OUTPUT_MAGIC, 8)) passed = false;
+    for(unsigned int i = 0; i < polys.size() and passed; i++) {
+      int status, textStatus;
+      uint32_t iters, nZeros;
+      unsigned int textIters;
+      if (fread(&status, 4, 1, bin) != 1 or fread(&iters, 4, 1, bin) != 1 or
+          fread(&nZeros, 4, 1, bin) != 1 or
+          fscanf(text, "%d %u", &textStatus, &textIters) != 2 or
+          status != textStatus or iters != textIters or
+          nZeros != (status < 0 ? 0 : polys[i].size() - 1)) {passed = false; break;}
+      ab::Polynomial<double> poly(polys[i]);
+      for(unsigned int k = 0; k < nZeros; k++) {
+        std::complex<double> zero;
+        double re, im;
+        if (fread(&zero, 16, 1, bin) != 1 or fscanf(text, "%lf %lf", &re, &im) != 2 or
+            zero != std::complex<double>(re, im) or !(abs(poly.eval(zero)) < 1e-9)) passed = false;
+      }
+    }
+    fclose(text);
+    fclose(bin);
+    for (const char *path : {inText, inBin, outText, outBin}) remove(path);
+    if (!passed) {printf("Failed streaming pipeline\n"); exit(1);}
+  }
+
+  printf("Testing work-stealing batches...\n");
+  {
+    // mixed degrees, the largest split over threads
+    std::vector<std::vector<std::complex<double>>> batch;
+    for (const unsigned int deg : {3, 40, 7, 301, 1, 100, 12, 601, 5}) {
+      batch.push_back(deg % 2 ? ab::unityRootsCoeffs(deg) : ab::easyCoeffs(deg));
+    }
+    ab::MixedBatchZeroFinder<double> finder(batch);
+    finder.setNumThreads(4);
+    finder.setSplitDegree(200);
+
+    // each polynomial must be solved exactly as by its own serial finder,
+    // on every run
+    passed = true;
+    for (unsigned int run = 0; run < 2; run++) {
+      passed = finder.compZeros() and passed;
+      for (unsigned int b = 0; b < batch.size(); b++) {
+        ab::ZeroFinder<double> serial(batch[b], 1e-9, 200, "newton");
+        serial.compZeros();
+        if (serial.getZeros() != finder.getZeros(b) or !finder.getConv(b) or
+            serial.getIters() != finder.getIters(b)) passed = false;
+      }
+    }
+    if (!passed) {printf("Failed work-stealing batches\n"); exit(1);}
+  }
+
+  printf("Testing seeded guesses...\n");
+  {
+    // draws filled at once are those drawn one at a time
+    ab::SplitMix rng(42), other(42);
+    std::vector<double> draws(101);
+    rng.fill(draws.data(), 1);
+    rng.fill(draws.data() + 1, 100);
+    passed = true;
+    for (const double draw : draws) {
+      if (draw != (other.next() >> 11) * 0x1p-53 or !(0 <= draw and draw < 1)) passed = false;
+    }
+
+    // guesses depend only on the seed, not on std::rand or on other finders
+    coeffs = ab::easyCoeffs(50);
+    ab::ZeroFinder<double> first(coeffs), second(coeffs);
+    std::srand(1);
+    ab::ZeroFinder<double> third(coeffs);
+    passed = passed and first.getZeros() == second.getZeros() and
+      first.getZeros() == third.getZeros();
+    third.setSeed(7);
+    passed = passed and first.getZeros() != third.getZeros();
+    first.setSeed(7);
+    passed = passed and first.getZeros() == third.getZeros();
+
+    // random guesses of a batch don't depend on the threads drawing them,
+    // each polynomial being solved as by its own finder
+    std::vector<std::vector<std::complex<double>>> batch;
+    for (const unsigned int deg : {30, 5, 60, 12, 45, 20}) batch.push_back(ab::easyCoeffs(deg));
+    for (const char *initMode : {"rand", "symm"}) {
+      ab::MixedBatchZeroFinder<double> serial(batch, 1e-9, 200, initMode),
+                                       parallel(batch, 1e-9, 200, initMode);
+      serial.setNumThreads(1);
+      parallel.setNumThreads(4);
+      serial.setSeed(3);
+      parallel.setSeed(3);
+      serial.compZeros();
+      parallel.compZeros();
+      for (unsigned int b = 0; b < batch.size(); b++) {
+        ab::ZeroFinder<double> finder(batch[b], 1e-9, 200, initMode);
+        finder.setSeed(ab::SplitMix(3).at(b));
+        finder.compZeros();
+        if (serial.getZeros(b) != parallel.getZeros(b) or
+            finder.getZeros() != parallel.getZeros(b)) passed = false;
+      }
+    }
+    if (!passed) {printf("Failed seeded guesses\n"); exit(1);}
+  }
+
+  printf("Testing sparse evaluation...\n");
+  {
+    // a few terms of high degree are evaluated term by term
+    const unsigned int n = 2000;
+    const std::vector<unsigned int> exps = {0, 7, 1000, n};
+    std::vector<std::complex<double>> sparse(n + 1, 0.0);
+    for (const unsigned int e : exps) sparse[e] = {1e150, -1e150 / (e + 1)};
+    ab::Polynomial<double> poly(sparse);
+    passed = poly.isSparse() and !ab::Polynomial<double>(ab::easyCoeffs(100)).isSparse();
+
+    // values and derivatives agree with long double sums, within the
+    // error bound, inside the unit circle and beyond it, where they only
+    // stay finite scaled
+    std::srand(8008335);
+    for(unsigned int k = 0; k < 100; k++) {
+      const std::complex<double> x = std::polar(k < 50 ? std::rand() / (RAND_MAX + 1.0) : 1.5,
+          6.283185307179586 * std::rand() / RAND_MAX);
+      const std::complex<long double> xL = x;
+      std::complex<long double> val = 0, deriv = 0, pow = 1, prevPow = 0;
+      for (unsigned int e = 0; e <= n; e++) {
+        const std::complex<long double> coeff = sparse[e];
+        val += coeff * pow;
+        deriv += coeff * static_cast<long double>(e) * prevPow;
+        prevPow = pow;
+        pow *= xL;
+      }
+      std::complex<double> valS, derivS;
+      double bound;
+      const int exp = poly.evalDerivScaled(x, valS, derivS, &bound);
+      const long double scale = std::ldexp(1.0L, exp);
+      if (!(abs(scale * static_cast<std::complex<long double>>(valS) - val) <=
+            scale * bound + 1e-12L * abs(val)) or
+          1e-12L * abs(deriv) < abs(scale * static_cast<std::complex<long double>>(derivS) - deriv)) {
+        passed = false;
+      }
+    }
+
+    // zeros of sparse polynomials are found as before
+    for (const auto &sparseCoeffs : {ab::unityRootsCoeffs(500), ab::mignotteCoeffs(50)}) {
+      ab::ZeroFinder<double> finder(sparseCoeffs, 1e-9, 200, "newton");
+      passed = finder.compZeros() and passed;
+    }
+    if (!passed) {printf("Failed sparse evaluation\n"); exit(1);}
+  }
+
+  printf("Testing high-degree polynomials...\n");
+  {
+    // scaled evaluation stays finite where plain Horner overflows
+    const unsigned int n = 2000;
+    std::vector<std::complex<double>> big(n + 1, 1e306);
+    ab::Polynomial<double> poly(big);
+    std::complex<double> val, deriv;
+    const int exp = poly.evalDerivScaled(1.0, val, deriv);
+    if (std::isfinite(abs(poly.eval(1.0))) or
+        1e-9 < abs(std::ldexp(abs(val) / 1e306, exp) / (n + 1) - 1) or
+        1e-9 < abs(std::ldexp(abs(deriv) / 1e306, exp) / (n * (n + 1) / 2) - 1)) {
+      printf("Failed scaled evaluation\n"); exit(1);
+    }
+
+    // z^n - 1 and 1 + z + ... + z^n, whose values at the Cauchy bound
+    // overflow for this degree
+    std::vector<std::complex<double>> unity(n + 1, 0.0),
+                                      ones(n + 1, 1.0);
+    unity[0] = -1;
+    unity[n] = 1;
+    for (const auto &highCoeffs : {unity, ones}) {
+      ab::ZeroFinder<double> finder(highCoeffs, 1e-9, 200, "newton");
+      finder.setActiveSet(true);
+      passed = finder.compZeros();
+      if (!passed) {printf("Failed high-degree polynomial\n"); exit(1);}
+    }
+  }
+
+  printf("Testing double-double arithmetic...\n");
+  {
+    // identities hold to the working precision, far below that of double
+    auto identities = [](const auto one) {
+      using E = std::decay_t<decltype(one)>;
+      const E eps = std::numeric_limits<E>::epsilon(),
+              third = one / 3,
+              root2 = sqrt(2 * one),
+              x = one * 7 / 10;
+      return eps < 1e-30 and
+             abs(third * 3 - 1) <= 2 * eps and
+             abs(root2 * root2 - 2) <= 8 * eps and
+             abs(exp(log(3 * one)) - 3) <= 64 * eps and
+             abs(sin(x) * sin(x) + cos(x) * cos(x) - 1) <= 16 * eps;
+    };
+    passed = identities(ab::DoubleDouble(1)) and identities(ab::QuadDouble(1));
+
+    // Wilkinson's polynomial of degree 20, whose coeffs are exact here but
+    // not in double, where its zeros come out wrong in the first digits
+    auto wilkinsonErr = [](const auto one) {
+      using E = std::decay_t<decltype(one)>;
+      const unsigned int n = 20;
+      std::vector<std::complex<E>> wilkinson(n + 1, 0 * one);
+      wilkinson[0] = one;
+      for(unsigned int k = 1; k <= n; k++) {
+        for(unsigned int i = k; 0 < i; i--) wilkinson[i] = wilkinson[i - 1] - wilkinson[i] * (one * k);
+        wilkinson[0] *= -(one * k);
+      }
+      ab::ZeroFinder<E> finder(wilkinson, 1e-30, 200, "newton");
+      finder.setStopCriterion("bound");
+      double err = finder.compZeros() ? 0 : 1;
+      for (const auto &zero : finder.getZeros()) {
+        E dist = abs(zero - one);
+        for(unsigned int k = 2; k <= n; k++) dist = std::min(dist, abs(zero - one * k));
+        err = std::max(err, static_cast<double>(dist));
+      }
+      return err;
+    };
+    passed = wilkinsonErr(ab::DoubleDouble(1)) < 1e-15 and
+      wilkinsonErr(ab::QuadDouble(1)) < 1e-45 and passed;
+    if (!passed) {printf("Failed double-double arithmetic\n"); exit(1);}
+  }
+
+  printf("Testing adaptive precision...\n");
+  for(unsigned int n = 20; n <= 80; n += 30) {
+
+    // (x - 1/2)^3 (x^n - 1), whose coeffs are exact in double, but whose
+    // triple zero double only resolves to about eps^(1/3)
+    std::vector<std::complex<double>> triple(n + 4, 0);
+    const double cube[4] = {-0.125, 0.75, -1.5, 1};
+    for(unsigned int j = 0; j < 4; j++) {
+      triple[j] -= cube[j];
+      triple[n + j] += cube[j];
+    }
+    ab::ZeroFinder<double> finder(triple, 1e-30, 200, "newton");
+    finder.setPrecisionMode("adaptive");
+    finder.setStats(true);
+    passed = finder.compZeros();
+
+    // only the zeros of the triple zero are iterated in double-double, and
+    // come out far more accurate, while the roots of unity stay in double
+    double tripleErr = 0,
+           unityErr = 0;
+    for (const auto &zero : finder.getZeros()) {
+      if (abs(zero - 0.5) < 1e-3) tripleErr = std::max(tripleErr, abs(zero - 0.5));
+      else unityErr = std::max(unityErr, std::abs(abs(zero) - 1));
+    }
+    passed = passed and tripleErr < 1e-9 and unityErr < 1e-14 and
+      finder.getStats().activeRows.back() <= 3;
+    if (!passed) {printf("Failed adaptive precision with n = %u\n", n); exit(1);}
+  }
+
   if (passed) printf("All tests passed! :)\n");
 }
@@ -99,4 +99,79 @@ namespace aberth
 
   }
 
+  //----------------------------------------------------------------------------//
+  //! wilkinson, (x - 1)(x - 2)...(x - deg)
+  //----------------------------------------------------------------------------//
+  std::vector<std::complex<double>> wilkinsonCoeffs(const unsigned int deg)
+  {
+
+    // assert constraint on degree of polynomial
+    assert(deg <= 20 and "Degree of polynomial for wilkinsonCoeffs must be <= 20");
+
+    // multiply by one factor at a time
+    std::vector<std::complex<double>> coeffs(deg + 1, 0);
+    coeffs[0] = 1;
+    for(unsigned int k = 1; k <= deg; k++) {
+      for(unsigned int i = k; 0 < i; i--) {
+        coeffs[i] = coeffs[i - 1] - static_cast<double>(k) * coeffs[i];
+      }
+      coeffs[0] *= -static_cast<double>(k);
+    }
+    return coeffs;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! mignotte, x^deg - 2(10x - 1)^2, with two zeros very close to 1/10
+  //----------------------------------------------------------------------------//
+  std::vector<std::complex<double>> mignotteCoeffs(const unsigned int deg)
+  {
+
+    // assert constraint on degree of polynomial
+    assert(3 <= deg and "Degree of polynomial for mignotteCoeffs must be >= 3");
+
+    std::vector<std::complex<double>> coeffs(deg + 1, 0);
+    coeffs[0] = -2;
+    coeffs[1] = 40;
+    coeffs[2] = -200;
+    coeffs[deg] = 1;
+    return coeffs;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! chebyshev polynomial of the first kind
+  //! from T_{k + 1} = 2x T_k - T_{k - 1}
+  //----------------------------------------------------------------------------//
+  std::vector<std::complex<double>> chebyshevCoeffs(const unsigned int deg)
+  {
+
+    // assert constraint on degree of polynomial
+    assert(1 <= deg and deg <= 1000 and
+        "Degree of polynomial for chebyshevCoeffs must be in [1, 1000]");
+
+    std::vector<std::complex<double>> prev(deg + 1, 0),
+                                      coeffs(deg + 1, 0);
+    prev[0] = 1;
+    coeffs[1] = 1;
+    for(unsigned int k = 1; k < deg; k++) {
+      for(unsigned int i = 0; i <= k + 1; i++) {
+        prev[i] = (i ? 2. * coeffs[i - 1] : 0.) - prev[i];
+      }
+      std::swap(prev, coeffs);
+    }
+    return coeffs;
+  }
+
+  //----------------------------------------------------------------------------//
+  //! random, with real and imag parts of coeffs uniform in [-1, 1]
+  //----------------------------------------------------------------------------//
+  std::vector<std::complex<double>> randomCoeffs(const unsigned int deg)
+  {
+
+    std::vector<std::complex<double>> coeffs(deg + 1);
+    for(unsigned int i = 0; i <= deg; i++) {
+      coeffs[i] = {2. * std::rand() / RAND_MAX - 1, 2. * std::rand() / RAND_MAX - 1};
+    }
+    return coeffs;
+  }
+
 }
@@ -44,6 +44,26 @@ namespace aberth
   //----------------------------------------------------------------------------//
   std::vector<std::complex<double>> unityRootsCoeffs(const unsigned int deg);
 
+  //----------------------------------------------------------------------------//
+  //! wilkinson, (x - 1)(x - 2)...(x - deg)
+  //----------------------------------------------------------------------------//
+  std::vector<std::complex<double>> wilkinsonCoeffs(const unsigned int deg);
+
+  //----------------------------------------------------------------------------//
+  //! mignotte, x^deg - 2(10x - 1)^2, with two zeros very close to 1/10
+  //----------------------------------------------------------------------------//
+  std::vector<std::complex<double>> mignotteCoeffs(const unsigned int deg);
+
+  //----------------------------------------------------------------------------//
+  //! chebyshev polynomial of the first kind
+  //----------------------------------------------------------------------------//
+  std::vector<std::complex<double>> chebyshevCoeffs(const unsigned int deg);
+
+  //----------------------------------------------------------------------------//
+  //! random, with real and imag parts of coeffs uniform in [-1, 1]
+  //----------------------------------------------------------------------------//
+  std::vector<std::complex<double>> randomCoeffs(const unsigned int deg);
+
 }
 
 